@@ -0,0 +1,35 @@
+/*!
+    \file       cgcs_bench.h
+    \brief      Timing helpers shared by the cgcs_slist benchmarks
+ */
+
+#ifndef CGCS_BENCH_H
+#define CGCS_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Intervals must not jump when the wall clock is adjusted;
+// TIME_UTC (portable C11) only where CLOCK_MONOTONIC is unavailable.
+static inline uint64_t
+cgcs_bench_now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)(ts.tv_sec) * 1000000000u + (uint64_t)(ts.tv_nsec);
+}
+
+// Prints one result row: total time, and time per operation.
+static inline void
+cgcs_bench_report(const char *label, uint64_t elapsed_ns, uint64_t ops) {
+    printf("%-40s %12.3f ms %10.3f ns/op\n",
+           label,
+           (double)(elapsed_ns) / 1e6,
+           ops ? (double)(elapsed_ns) / (double)(ops) : 0.0);
+}
+
+#endif /* CGCS_BENCH_H */
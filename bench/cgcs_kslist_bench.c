@@ -0,0 +1,88 @@
+/*!
+    \file       cgcs_kslist_bench.c
+    \brief      String-keyed lookups: slist_find vs. kslist_find
+
+    Usage:
+        cgcs_kslist_bench [element-count]
+ */
+
+#include "cgcs_slist.h"
+#include "cgcs_kslist.h"
+#include "cgcs_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUPS 2000
+
+static inline int cmp_cstr(const void *lhs, const void *rhs) {
+    return strcmp(*(char **)(lhs), *(char **)(rhs));
+}
+
+// Keys share a long common prefix, so every strcmp does real work.
+static char *make_key(long n) {
+    char *str = malloc(64);
+    assert(str);
+    snprintf(str, 64, "com.example.service.endpoint.%ld", n);
+    return str;
+}
+
+int main(int argc, const char *argv[]) {
+    const long count = argc > 1 ? atol(argv[1]) : 10000;
+    char **keys = malloc(sizeof *keys * (size_t)(count));
+    char **probes = malloc(sizeof *probes * LOOKUPS);
+    slist_t sl = CGCS_SLIST_INITIALIZER;
+    kslist_t ks;
+    uint64_t start = 0;
+    size_t hits = 0;
+    assert(keys && probes);
+
+    kslist_init(&ks, kslist_hash_cstr, cmp_cstr);
+
+    for (long i = 0; i < count; i++) {
+        keys[i] = make_key(i);
+        slist_push_front(&sl, &keys[i]);
+        kslist_insert(&ks, &keys[i]);
+    }
+
+    // Half of the probes are present, half are not.
+    srand(1);
+    for (long i = 0; i < LOOKUPS; i++) {
+        probes[i] = make_key(i % 2 ? rand() % count : count + rand() % count);
+    }
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < LOOKUPS; i++) {
+        hits += slist_find(&sl, cmp_cstr, &probes[i]) != slist_end(&sl);
+    }
+    cgcs_bench_report("slist_find (strcmp every node)", cgcs_bench_now_ns() - start, LOOKUPS);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < LOOKUPS; i++) {
+        hits += kslist_find(&ks, &probes[i]) != NULL;
+    }
+    cgcs_bench_report("kslist_find (fingerprints first)", cgcs_bench_now_ns() - start, LOOKUPS);
+
+    printf("(hits: %zu of %d)\n", hits, 2 * LOOKUPS);
+
+    for (long i = 0; i < count; i++) {
+        kslist_erase(&ks, &keys[i]);
+        free(keys[i]);
+    }
+
+    for (long i = 0; i < LOOKUPS; i++) {
+        free(probes[i]);
+    }
+
+    printf("(remaining: %zu)\n", kslist_size(&ks));
+
+    while (!slist_empty(&sl)) {
+        slist_pop_front(&sl);
+    }
+
+    kslist_deinit(&ks);
+    free(probes);
+    free(keys);
+    return 0;
+}
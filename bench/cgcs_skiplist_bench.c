@@ -0,0 +1,128 @@
+/*!
+    \file       cgcs_skiplist_bench.c
+    \brief      Sorted slist_t vs. skiplist_t benchmark
+
+    Usage:
+        cgcs_skiplist_bench [element-count]
+ */
+
+#include "cgcs_slist.h"
+#include "cgcs_skiplist.h"
+#include "cgcs_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static long sum = 0;
+
+static inline void sum_long(void *arg) { sum += *(long *)(arg); }
+
+static inline int cmp_long(const void *lhs, const void *rhs) {
+    return (*(long *)(lhs) > *(long *)(rhs)) - (*(long *)(lhs) < *(long *)(rhs));
+}
+
+// The sorted slist_t approach: walk to the insertion point, insert after it.
+static void sorted_insert(slist_t *sl, const long *key) {
+    slist_iterator_t it = slist_before_begin(sl);
+
+    while (it->m_next != slist_end(sl) && cmp_long(key, &(it->m_next->m_data)) >= 0) {
+        it = it->m_next;
+    }
+
+    slist_insert_after(sl, it, key);
+}
+
+// Walk to the node before the first match, erase after it.
+static void sorted_erase(slist_t *sl, const long *key) {
+    slist_iterator_t it = slist_before_begin(sl);
+
+    while (it->m_next != slist_end(sl) && cmp_long(key, &(it->m_next->m_data)) > 0) {
+        it = it->m_next;
+    }
+
+    if (it->m_next != slist_end(sl) && cmp_long(key, &(it->m_next->m_data)) == 0) {
+        slist_erase_after(sl, it);
+    }
+}
+
+static bool is_sorted(slist_t *sl) {
+    for (slist_iterator_t it = slist_begin(sl); it && it->m_next; it = it->m_next) {
+        if (cmp_long(&(it->m_data), &(it->m_next->m_data)) > 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, const char *argv[]) {
+    const long count = argc > 1 ? atol(argv[1]) : 20000;
+    long *keys = malloc(sizeof *keys * (size_t)(count));
+    slist_t sl = CGCS_SLIST_INITIALIZER;
+    skiplist_t sk;
+    uint64_t start = 0;
+    size_t hits = 0;
+    assert(keys);
+
+    srand(1);
+    for (long i = 0; i < count; i++) {
+        keys[i] = rand();
+    }
+
+    skiplist_init(&sk, cmp_long);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        sorted_insert(&sl, &keys[i]);
+    }
+    cgcs_bench_report("insert: sorted slist_t", cgcs_bench_now_ns() - start, count);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        skiplist_insert(&sk, &keys[i]);
+    }
+    cgcs_bench_report("insert: skiplist_t", cgcs_bench_now_ns() - start, count);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        hits += slist_find(&sl, cmp_long, &keys[i]) != slist_end(&sl);
+    }
+    cgcs_bench_report("find: sorted slist_t", cgcs_bench_now_ns() - start, count);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        hits += skiplist_find(&sk, &keys[i]) != skiplist_end(&sk);
+    }
+    cgcs_bench_report("find: skiplist_t", cgcs_bench_now_ns() - start, count);
+
+    // Range iteration: elements in [RAND_MAX / 4, RAND_MAX / 2).
+    const long lo = RAND_MAX / 4;
+    const long hi = RAND_MAX / 2;
+
+    start = cgcs_bench_now_ns();
+    skiplist_foreach_range(&sk, sum_long, &lo, &hi);
+    cgcs_bench_report("foreach_range: skiplist_t", cgcs_bench_now_ns() - start, 1);
+
+    // The bottom level is an slist chain: existing slist code walks it as-is.
+    slist_foreach(skiplist_as_slist(&sk), sum_long);
+    printf("(hits: %zu, sum: %ld, sorted: %s)\n", hits, sum,
+           is_sorted(skiplist_as_slist(&sk)) && is_sorted(&sl) ? "true" : "false");
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        sorted_erase(&sl, &keys[i]);
+    }
+    cgcs_bench_report("erase: sorted slist_t", cgcs_bench_now_ns() - start, count);
+
+    start = cgcs_bench_now_ns();
+    for (long i = 0; i < count; i++) {
+        skiplist_erase(&sk, &keys[i]);
+    }
+    cgcs_bench_report("erase: skiplist_t", cgcs_bench_now_ns() - start, count);
+
+    printf("(remaining: %zu, %s)\n", skiplist_size(&sk), slist_empty(&sl) ? "empty" : "not empty");
+
+    skiplist_deinit(&sk);
+    free(keys);
+    return 0;
+}
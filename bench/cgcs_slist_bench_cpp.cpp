@@ -0,0 +1,161 @@
+/*!
+    \file       cgcs_slist_bench_cpp.cpp
+    \brief      C slist_t vs. cgcs::slist<T, Alloc> benchmark
+ */
+
+#include "cgcs_slist.hpp"
+#include "cgcs_bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#define NODE_COUNT  (1 << 16)
+#define ROUNDS      256
+
+static long sum = 0;
+
+static void sum_long(void *arg) { sum += *(long *)(arg); }
+
+static int cmp_long(const void *lhs, const void *rhs) {
+    return (*(long *)(lhs) > *(long *)(rhs)) - (*(long *)(lhs) < *(long *)(rhs));
+}
+
+// Larger than a pointer: stored inline, no casts or separate allocation.
+struct point3 {
+    long x;
+    long y;
+    long z;
+};
+
+template <typename List>
+static uint64_t build(List &list) {
+    const uint64_t start = cgcs_bench_now_ns();
+
+    for (long i = 0; i < NODE_COUNT; i++) {
+        list.push_front(i);
+    }
+
+    return cgcs_bench_now_ns() - start;
+}
+
+int main(int argc, const char *argv[]) {
+    slist_t sl = CGCS_SLIST_INITIALIZER;
+    cgcs::slist<long> cs;
+    const long key = -1;  // not present: every find walks all nodes
+    const uint64_t ops = (uint64_t)(NODE_COUNT) * ROUNDS;
+    uint64_t start = 0;
+    size_t misses = 0;
+
+    for (long i = 0; i < NODE_COUNT; i++) {
+        slist_push_front(&sl, &i);
+    }
+
+    cgcs_bench_report("build: cgcs::slist<long> (std::allocator)", build(cs), NODE_COUNT);
+
+    // Copy, then move, assignment; the copy is checked against cs.
+    cgcs::slist<long> cs_copy;
+    start = cgcs_bench_now_ns();
+    cs_copy = cs;
+    cgcs_bench_report("copy assign: cgcs::slist<long>", cgcs_bench_now_ns() - start, NODE_COUNT);
+
+    cgcs::slist<long> cs_moved;
+    start = cgcs_bench_now_ns();
+    cs_moved = std::move(cs_copy);
+    cgcs_bench_report("move assign: cgcs::slist<long>", cgcs_bench_now_ns() - start, 1);
+    bool assigned = cs_copy.empty() && std::equal(cs.begin(), cs.end(), cs_moved.begin(), cs_moved.end());
+
+#if defined(__cpp_lib_memory_resource)
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::monotonic_buffer_resource other_arena;
+        cgcs::pmr::slist<long> ps(&arena);
+        cgcs_bench_report("build: cgcs::pmr::slist<long> (monotonic)", build(ps), NODE_COUNT);
+
+        // polymorphic_allocator does not propagate: each list keeps its resource.
+        cgcs::pmr::slist<long> ps_copy(&arena);
+        start = cgcs_bench_now_ns();
+        ps_copy = ps;
+        cgcs_bench_report("copy assign: cgcs::pmr::slist<long>", cgcs_bench_now_ns() - start, NODE_COUNT);
+
+        cgcs::pmr::slist<long> ps_same(&arena);
+        start = cgcs_bench_now_ns();
+        ps_same = std::move(ps_copy);
+        cgcs_bench_report("move assign: cgcs::pmr::slist<long> (same resource)",
+                          cgcs_bench_now_ns() - start, 1);
+
+        cgcs::pmr::slist<long> ps_other(&other_arena);
+        start = cgcs_bench_now_ns();
+        ps_other = std::move(ps_same);
+        cgcs_bench_report("move assign: cgcs::pmr::slist<long> (other resource)",
+                          cgcs_bench_now_ns() - start, NODE_COUNT);
+
+        assigned = assigned && ps_copy.empty() && ps_same.empty()
+                   && ps_other.get_allocator().resource() == &other_arena
+                   && std::equal(ps.begin(), ps.end(), ps_other.begin(), ps_other.end());
+    }
+#endif
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        misses += slist_find(&sl, cmp_long, &key) == slist_end(&sl);
+    }
+    cgcs_bench_report("find: slist_find (function pointer)", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        misses += cs.find(key) == cs.end();
+    }
+    cgcs_bench_report("find: cgcs::slist<long>::find", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        misses += std::find(cs.begin(), cs.end(), key) == cs.end();
+    }
+    cgcs_bench_report("find: std::find on cgcs::slist<long>", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        slist_foreach(&sl, sum_long);
+    }
+    cgcs_bench_report("foreach: slist_foreach (function pointer)", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        cs.foreach([](long value) { sum += value; });
+    }
+    cgcs_bench_report("foreach: cgcs::slist<long>::foreach", cgcs_bench_now_ns() - start, ops);
+
+    // long is pointer-sized and trivially copyable: the C functions walk cs directly.
+    static_assert(cgcs::slist<long>::c_layout_compatible, "cgcs::slist<long> nodes match cgcs_slist_node");
+    const long before = sum;
+    const long probe = NODE_COUNT / 2;
+    slist_foreach(cs.c_list(), sum_long);
+
+    slist_iterator_t found = slist_find(cs.c_list(), cmp_long, &probe);
+    const bool interop = sum - before == (long)(NODE_COUNT) * (NODE_COUNT - 1) / 2
+                         && found != slist_end(cs.c_list())
+                         && *cgcs::slist<long>::from_c_iterator(found) == probe;
+
+    // Move-only elements, emplace and remove_if.
+    cgcs::slist<std::unique_ptr<std::string>> owned;
+    for (int i = 0; i < 8; i++) {
+        owned.emplace_front(std::make_unique<std::string>(std::to_string(i)));
+    }
+    const size_t removed = owned.remove_if([](const std::unique_ptr<std::string> &s) { return (*s)[0] % 2 == 0; });
+
+    cgcs::slist<point3> points { { 1, 2, 3 }, { 4, 5, 6 } };
+    points.emplace_after(points.begin(), point3 { 7, 8, 9 });
+    static_assert(!cgcs::slist<point3>::c_layout_compatible, "point3 is larger than a pointer");
+
+    printf("(misses: %zu, sum: %ld, removed: %zu, points: %ld, assignment: %s, C interop: %s)\n",
+           misses, sum, removed, (long)(std::distance(points.begin(), points.end())),
+           assigned ? "ok" : "FAILED", interop ? "ok" : "FAILED");
+
+    while (!slist_empty(&sl)) {
+        slist_pop_front(&sl);
+    }
+
+    return 0;
+}
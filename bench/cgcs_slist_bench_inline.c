@@ -0,0 +1,72 @@
+/*!
+    \file       cgcs_slist_bench_inline.c
+    \brief      Indirect-call vs. inlined-callback traversal benchmark
+ */
+
+#include "cgcs_slist.h"
+#include "cgcs_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NODE_COUNT  (1 << 16)
+#define ROUNDS      256
+
+static long sum = 0;
+
+// Elements are long, so each one fills m_data entirely.
+static inline void sum_long(void *arg) { sum += *(long *)(arg); }
+
+static inline int cmp_long(const void *lhs, const void *rhs) {
+    return (*(long *)(lhs) > *(long *)(rhs)) - (*(long *)(lhs) < *(long *)(rhs));
+}
+
+CGCS_SLIST_DEFINE_FIND(slist_find_long, cmp_long)
+CGCS_SLIST_DEFINE_FOREACH(slist_foreach_sum_long, sum_long)
+
+int main(int argc, const char *argv[]) {
+    slist_t sl = CGCS_SLIST_INITIALIZER;
+
+    for (long i = 0; i < NODE_COUNT; i++) {
+        slist_push_front(&sl, &i);
+    }
+
+    // A key that is not in the list -- every find walks all nodes.
+    long key = -1;
+    const uint64_t ops = (uint64_t)(NODE_COUNT) * ROUNDS;
+    uint64_t start = 0;
+    size_t misses = 0;
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        misses += slist_find(&sl, cmp_long, &key) == slist_end(&sl);
+    }
+    cgcs_bench_report("slist_find (function pointer)", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        misses += slist_find_long(&sl, &key) == slist_end(&sl);
+    }
+    cgcs_bench_report("CGCS_SLIST_DEFINE_FIND (inlined)", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        slist_foreach(&sl, sum_long);
+    }
+    cgcs_bench_report("slist_foreach (function pointer)", cgcs_bench_now_ns() - start, ops);
+
+    start = cgcs_bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        slist_foreach_sum_long(&sl);
+    }
+    cgcs_bench_report("CGCS_SLIST_DEFINE_FOREACH (inlined)", cgcs_bench_now_ns() - start, ops);
+
+    // Keep the results observable so the loops are not optimized away.
+    printf("(misses: %zu, sum: %ld)\n", misses, sum);
+
+    while (!slist_empty(&sl)) {
+        slist_pop_front(&sl);
+    }
+
+    return 0;
+}
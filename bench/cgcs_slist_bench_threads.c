@@ -0,0 +1,124 @@
+/*!
+    \file       cgcs_slist_bench_threads.c
+    \brief      malloc vs. slist_cache_alloc scaling benchmark, 1 to N threads
+
+    Usage:
+        cgcs_slist_bench_threads [max-threads]
+
+    local:   each thread builds and destroys its own lists.
+    handoff: each thread builds a list, then a different thread destroys it
+             (every free is of a node allocated by another thread).
+ */
+
+#include "cgcs_slist.h"
+#include "cgcs_slist_cache.h"
+#include "cgcs_bench.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NODE_COUNT  (1 << 14)
+#define ROUNDS      64
+
+struct worker {
+    pthread_t m_thread;
+    slist_t m_list;
+    bool m_use_cache;
+};
+
+static void build(struct worker *w) {
+    for (long i = 0; i < NODE_COUNT; i++) {
+        if (w->m_use_cache) {
+            slist_push_front_alloc_fn(&w->m_list, &i, slist_cache_alloc);
+        } else {
+            slist_push_front(&w->m_list, &i);
+        }
+    }
+}
+
+static void destroy(struct worker *w) {
+    if (w->m_use_cache) {
+        slist_deinit_free_fn(&w->m_list, slist_cache_free);
+    } else {
+        slist_deinit(&w->m_list);
+    }
+}
+
+static void *run_local(void *arg) {
+    struct worker *w = arg;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        build(w);
+        destroy(w);
+    }
+
+    return NULL;
+}
+
+static void *run_build(void *arg) {
+    for (int r = 0; r < ROUNDS; r++) {
+        build(arg);
+    }
+
+    return NULL;
+}
+
+static void *run_destroy(void *arg) {
+    destroy(arg);
+    return NULL;
+}
+
+static void spawn_join(struct worker *workers, int count, void *(*fn)(void *), int shift) {
+    for (int i = 0; i < count; i++) {
+        pthread_create(&workers[i].m_thread, NULL, fn, &workers[(i + shift) % count]);
+    }
+
+    for (int i = 0; i < count; i++) {
+        pthread_join(workers[i].m_thread, NULL);
+    }
+}
+
+static void bench(int threads, bool use_cache, bool handoff) {
+    struct worker *workers = calloc(threads, sizeof *workers);
+    char label[64];
+    assert(workers);
+
+    for (int i = 0; i < threads; i++) {
+        slist_init(&workers[i].m_list);
+        workers[i].m_use_cache = use_cache;
+    }
+
+    const uint64_t start = cgcs_bench_now_ns();
+
+    if (handoff) {
+        // Lists built by thread i are destroyed by thread i + 1.
+        spawn_join(workers, threads, run_build, 0);
+        spawn_join(workers, threads, run_destroy, 1);
+    } else {
+        spawn_join(workers, threads, run_local, 0);
+    }
+
+    const uint64_t elapsed = cgcs_bench_now_ns() - start;
+    const uint64_t nodes = (uint64_t)(threads) * NODE_COUNT * ROUNDS;
+
+    snprintf(label, sizeof label, "%-7s %-6s threads: %2d",
+             handoff ? "handoff" : "local", use_cache ? "cache" : "malloc", threads);
+    cgcs_bench_report(label, elapsed, nodes);
+    printf("%40s %12.3f Mnodes/s\n", "", (double)(nodes) * 1e3 / (double)(elapsed));
+
+    free(workers);
+}
+
+int main(int argc, const char *argv[]) {
+    const int max_threads = argc > 1 ? atoi(argv[1]) : 8;
+
+    for (int handoff = 0; handoff <= 1; handoff++) {
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            bench(threads, false, handoff);
+            bench(threads, true, handoff);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,563 @@
+/*!
+    \file       cgcs_slist_replay.c
+    \brief      Replays an slist operation trace and reports throughput/latency
+
+    Usage:
+        cgcs_slist_replay [-a malloc|pool|cache] trace.bin
+        cgcs_slist_replay -g trace.bin [op-count]
+
+    -a selects the node allocator used for the replay
+       (cache: slist_cache_alloc, see cgcs_slist_cache.h).
+    -g records a synthetic workload to trace.bin
+       (requires a library built with CGCS_SLIST_TRACE).
+
+    Build the library in other configurations
+    (CGCS_SLIST_HEADER_ONLY, CGCS_SLIST_LTO, ...) and replay
+    the same trace to compare them. Replay with a library built
+    without CGCS_SLIST_TRACE: otherwise every replayed call also
+    checks whether a trace is open, and a warning is printed.
+
+    Each op is timed on its own; the median cost of a pair of
+    cgcs_bench_now_ns() calls is measured at startup and subtracted
+    from every sample, so latencies and throughput cover the slist
+    calls rather than the timer.
+ */
+
+#include "cgcs_slist.h"
+#include "cgcs_slist_trace.h"
+#include "cgcs_slist_cache.h"
+#include "cgcs_bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OP_COUNT (CGCS_SLIST_TRACE_DEINIT_STEP + 1)
+
+static const char *op_names[OP_COUNT] = {
+    [CGCS_SLIST_TRACE_INSERT_AFTER] = "insert_after",
+    [CGCS_SLIST_TRACE_PUSH_FRONT] = "push_front",
+    [CGCS_SLIST_TRACE_ERASE_AFTER] = "erase_after",
+    [CGCS_SLIST_TRACE_POP_FRONT] = "pop_front",
+    [CGCS_SLIST_TRACE_FIND] = "find",
+    [CGCS_SLIST_TRACE_TRANSFER] = "transfer",
+    [CGCS_SLIST_TRACE_DEINIT] = "deinit",
+    [CGCS_SLIST_TRACE_DEINIT_STEP] = "deinit_step"
+};
+
+// Pool allocator: fixed-size blocks carved out of large chunks,
+// recycled through an intrusive free list.
+struct pool_block {
+    struct pool_block *m_next;
+    unsigned char m_pad[sizeof(struct cgcs_slist_node) - sizeof(struct pool_block *)];
+};
+
+#define POOL_CHUNK_BLOCKS 4096
+
+static struct pool_block *pool_free_list = NULL;
+
+static void *pool_alloc(size_t size) {
+    assert(size <= sizeof(struct pool_block));
+
+    if (pool_free_list == NULL) {
+        // Chunks are intentionally never returned; the pool lives as long as the replay.
+        struct pool_block *chunk = malloc(sizeof *chunk * POOL_CHUNK_BLOCKS);
+        assert(chunk);
+
+        for (size_t i = 0; i < POOL_CHUNK_BLOCKS; i++) {
+            chunk[i].m_next = pool_free_list;
+            pool_free_list = &chunk[i];
+        }
+    }
+
+    struct pool_block *block = pool_free_list;
+    pool_free_list = block->m_next;
+    return block;
+}
+
+static void pool_free(void *ptr) {
+    struct pool_block *block = ptr;
+    block->m_next = pool_free_list;
+    pool_free_list = block;
+}
+
+// Maps recorded addresses to replay nodes (open addressing, linear probing).
+// A replay node's m_data holds the address it was recorded under,
+// so its entry can be dropped when the node is erased.
+struct addr_map {
+    uint64_t *m_keys;
+    struct cgcs_slist_node **m_values;
+    size_t m_capacity;
+    size_t m_size;
+};
+
+static inline size_t addr_hash(uint64_t key, size_t capacity) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return (size_t)(key) & (capacity - 1);
+}
+
+static void addr_map_put(struct addr_map *m, uint64_t key, struct cgcs_slist_node *value);
+
+static void addr_map_grow(struct addr_map *m) {
+    struct addr_map old = *m;
+
+    m->m_capacity = old.m_capacity ? old.m_capacity * 2 : 1024;
+    m->m_keys = calloc(m->m_capacity, sizeof *m->m_keys);
+    m->m_values = calloc(m->m_capacity, sizeof *m->m_values);
+    m->m_size = 0;
+    assert(m->m_keys && m->m_values);
+
+    for (size_t i = 0; i < old.m_capacity; i++) {
+        if (old.m_keys[i]) {
+            addr_map_put(m, old.m_keys[i], old.m_values[i]);
+        }
+    }
+
+    free(old.m_keys);
+    free(old.m_values);
+}
+
+static void addr_map_put(struct addr_map *m, uint64_t key, struct cgcs_slist_node *value) {
+    if ((m->m_size + 1) * 2 > m->m_capacity) {
+        addr_map_grow(m);
+    }
+
+    size_t i = addr_hash(key, m->m_capacity);
+    while (m->m_keys[i] && m->m_keys[i] != key) {
+        i = (i + 1) & (m->m_capacity - 1);
+    }
+
+    m->m_size += m->m_keys[i] == 0;
+    m->m_keys[i] = key;
+    m->m_values[i] = value;
+}
+
+static struct cgcs_slist_node *addr_map_get(struct addr_map *m, uint64_t key) {
+    if (key == 0 || m->m_capacity == 0) {
+        return NULL;
+    }
+
+    size_t i = addr_hash(key, m->m_capacity);
+    while (m->m_keys[i]) {
+        if (m->m_keys[i] == key) {
+            return m->m_values[i];
+        }
+
+        i = (i + 1) & (m->m_capacity - 1);
+    }
+
+    return NULL;
+}
+
+static void addr_map_remove(struct addr_map *m, uint64_t key) {
+    if (key == 0 || m->m_capacity == 0) {
+        return;
+    }
+
+    const size_t mask = m->m_capacity - 1;
+    size_t i = addr_hash(key, m->m_capacity);
+
+    while (m->m_keys[i] != key) {
+        if (m->m_keys[i] == 0) {
+            return;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    // Backward-shift deletion: no tombstones.
+    size_t j = i;
+    for (;;) {
+        m->m_keys[i] = 0;
+
+        do {
+            j = (j + 1) & mask;
+            if (m->m_keys[j] == 0) {
+                m->m_size--;
+                return;
+            }
+        } while (((j - addr_hash(m->m_keys[j], m->m_capacity)) & mask)
+                 < ((j - i) & mask));
+
+        m->m_keys[i] = m->m_keys[j];
+        m->m_values[i] = m->m_values[j];
+        i = j;
+    }
+}
+
+// Replay state
+static struct addr_map nodes = { NULL, NULL, 0, 0 };
+// NULL allocfn/freefn: slist_insert_after/slist_erase_after (malloc/free).
+static const char *alloc_name = "malloc";
+static void *(*replay_allocfn)(size_t) = NULL;
+static void (*replay_freefn)(void *) = NULL;
+static uint64_t *latencies[OP_COUNT];
+static size_t latency_counts[OP_COUNT];
+static size_t latency_capacity[OP_COUNT];
+static size_t skipped = 0;
+
+static void latency_add(int op, uint64_t ns) {
+    if (latency_counts[op] == latency_capacity[op]) {
+        latency_capacity[op] = latency_capacity[op] ? latency_capacity[op] * 2 : 1024;
+        latencies[op] = realloc(latencies[op], sizeof *latencies[op] * latency_capacity[op]);
+        assert(latencies[op]);
+    }
+
+    latencies[op][latency_counts[op]++] = ns;
+}
+
+static int cmp_u64(const void *lhs, const void *rhs) {
+    const uint64_t a = *(const uint64_t *)(lhs);
+    const uint64_t b = *(const uint64_t *)(rhs);
+    return (a > b) - (a < b);
+}
+
+// Cost of timing an op: a cgcs_bench_now_ns() pair around nothing.
+static uint64_t timer_overhead_ns = 0;
+
+static void timer_calibrate(void) {
+    enum { SAMPLES = 1001 };
+    uint64_t samples[SAMPLES];
+
+    for (int i = 0; i < SAMPLES; i++) {
+        const uint64_t start = cgcs_bench_now_ns();
+        samples[i] = cgcs_bench_now_ns() - start;
+    }
+
+    qsort(samples, SAMPLES, sizeof *samples, cmp_u64);
+    timer_overhead_ns = samples[SAMPLES / 2];
+}
+
+// slist_find passes (data, &(it->m_data)); data is &(target->m_data).
+static int cmp_identity(const void *lhs, const void *rhs) {
+    return lhs != rhs;
+}
+
+// Lists are created on first sight of their recorded address.
+static slist_t *replay_list(uint64_t addr) {
+    struct cgcs_slist_node *head = addr_map_get(&nodes, addr);
+
+    if (head == NULL) {
+        slist_t *sl = malloc(sizeof *sl);
+        assert(sl);
+        slist_init(sl);
+        addr_map_put(&nodes, addr, slist_before_begin(sl));
+        return sl;
+    }
+
+    return (slist_t *)(head);
+}
+
+static void replay_record(const struct cgcs_slist_trace_record *rec) {
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+
+    switch (rec->m_op) {
+    case CGCS_SLIST_TRACE_INSERT_AFTER:
+    case CGCS_SLIST_TRACE_PUSH_FRONT: {
+        slist_t *sl = replay_list(rec->m_self);
+        slist_iterator_t it = rec->m_op == CGCS_SLIST_TRACE_PUSH_FRONT
+                            ? slist_before_begin(sl)
+                            : addr_map_get(&nodes, rec->m_arg);
+        if (it == NULL) {
+            skipped++;
+            return;
+        }
+
+        start = cgcs_bench_now_ns();
+        it = replay_allocfn ? slist_insert_after_alloc_fn(sl, it, &rec->m_result, replay_allocfn)
+                            : slist_insert_after(sl, it, &rec->m_result);
+        elapsed = cgcs_bench_now_ns() - start;
+
+        addr_map_put(&nodes, rec->m_result, it);
+        break;
+    }
+    case CGCS_SLIST_TRACE_ERASE_AFTER:
+    case CGCS_SLIST_TRACE_POP_FRONT: {
+        slist_t *sl = replay_list(rec->m_self);
+        slist_iterator_t it = rec->m_op == CGCS_SLIST_TRACE_POP_FRONT
+                            ? slist_before_begin(sl)
+                            : addr_map_get(&nodes, rec->m_arg);
+        if (it == NULL || it->m_next == NULL) {
+            skipped++;
+            return;
+        }
+
+        addr_map_remove(&nodes, (uint64_t)(uintptr_t)(it->m_next->m_data));
+
+        start = cgcs_bench_now_ns();
+        if (replay_freefn) {
+            slist_erase_after_free_fn(sl, it, replay_freefn);
+        } else {
+            slist_erase_after(sl, it);
+        }
+        elapsed = cgcs_bench_now_ns() - start;
+        break;
+    }
+    case CGCS_SLIST_TRACE_FIND: {
+        slist_t *sl = replay_list(rec->m_self);
+        slist_iterator_t beg = rec->m_arg ? addr_map_get(&nodes, rec->m_arg) : slist_begin(sl);
+        slist_iterator_t target = addr_map_get(&nodes, rec->m_result);
+        if (rec->m_arg && beg == NULL) {
+            skipped++;
+            return;
+        }
+
+        start = cgcs_bench_now_ns();
+        slist_find_range(sl, cmp_identity, target ? &(target->m_data) : NULL, beg, slist_end(sl));
+        elapsed = cgcs_bench_now_ns() - start;
+        break;
+    }
+    case CGCS_SLIST_TRACE_TRANSFER: {
+        // An unknown destination is an empty list seen for the first time
+        // (e.g. the out list of slist_split_after); nodes are always known.
+        struct cgcs_slist_node *x = addr_map_get(&nodes, rec->m_self);
+        struct cgcs_slist_node *from = addr_map_get(&nodes, rec->m_arg);
+        struct cgcs_slist_node *finish = addr_map_get(&nodes, rec->m_result);
+        if (x == NULL) {
+            x = slist_before_begin(replay_list(rec->m_self));
+        }
+
+        if (from == NULL || (rec->m_result && finish == NULL)) {
+            skipped++;
+            return;
+        }
+
+        start = cgcs_bench_now_ns();
+        slist_node_transfer_after_range(x, from, finish);
+        elapsed = cgcs_bench_now_ns() - start;
+        break;
+    }
+    case CGCS_SLIST_TRACE_DEINIT: {
+        slist_t *sl = replay_list(rec->m_self);
+
+        for (slist_iterator_t it = slist_begin(sl); it != slist_end(sl); it = it->m_next) {
+            addr_map_remove(&nodes, (uint64_t)(uintptr_t)(it->m_data));
+        }
+
+        start = cgcs_bench_now_ns();
+        if (replay_freefn) {
+            slist_deinit_free_fn(sl, replay_freefn);
+        } else {
+            slist_deinit(sl);
+        }
+        elapsed = cgcs_bench_now_ns() - start;
+        break;
+    }
+    case CGCS_SLIST_TRACE_DEINIT_STEP: {
+        slist_t *sl = replay_list(rec->m_self);
+        const size_t budget = (size_t)(rec->m_arg);
+        size_t n = 0;
+
+        for (slist_iterator_t it = slist_begin(sl); it != slist_end(sl) && n < budget;
+             it = it->m_next, n++) {
+            addr_map_remove(&nodes, (uint64_t)(uintptr_t)(it->m_data));
+        }
+
+        start = cgcs_bench_now_ns();
+        if (replay_freefn) {
+            slist_deinit_step_free_fn(sl, budget, replay_freefn);
+        } else {
+            slist_deinit_step(sl, budget);
+        }
+        elapsed = cgcs_bench_now_ns() - start;
+        break;
+    }
+    default:
+        skipped++;
+        return;
+    }
+
+    latency_add(rec->m_op, elapsed > timer_overhead_ns ? elapsed - timer_overhead_ns : 0);
+}
+
+static int replay(const char *path) {
+    FILE *fp = slist_trace_reader_open(path);
+    struct cgcs_slist_trace_record rec;
+    uint64_t recorded_ns = 0;
+    uint64_t replayed_ns = 0;
+    size_t total = 0;
+
+    if (fp == NULL) {
+        fprintf(stderr, "cgcs_slist_replay: cannot read trace '%s'\n", path);
+        return EXIT_FAILURE;
+    }
+
+    timer_calibrate();
+
+    while (slist_trace_read(fp, &rec)) {
+        recorded_ns += rec.m_delta_ns;
+        replay_record(&rec);
+    }
+
+    fclose(fp);
+
+#ifdef CGCS_SLIST_TRACE
+    printf("warning: library built with CGCS_SLIST_TRACE; "
+           "replay timings include the recorder's check on every call\n");
+#endif
+    printf("allocator: %s\n", alloc_name);
+    printf("timer overhead: %llu ns per op (subtracted)\n",
+           (unsigned long long)(timer_overhead_ns));
+    printf("%-14s %10s %10s %10s %10s %10s\n",
+           "op", "count", "mean ns", "p50 ns", "p99 ns", "max ns");
+
+    for (int op = 1; op < OP_COUNT; op++) {
+        const size_t n = latency_counts[op];
+        uint64_t sum = 0;
+
+        if (n == 0) {
+            continue;
+        }
+
+        qsort(latencies[op], n, sizeof *latencies[op], cmp_u64);
+        for (size_t i = 0; i < n; i++) {
+            sum += latencies[op][i];
+        }
+
+        printf("%-14s %10zu %10.1f %10llu %10llu %10llu\n",
+               op_names[op], n, (double)(sum) / (double)(n),
+               (unsigned long long)(latencies[op][n / 2]),
+               (unsigned long long)(latencies[op][n - 1 - n / 100]),
+               (unsigned long long)(latencies[op][n - 1]));
+
+        total += n;
+        replayed_ns += sum;
+        free(latencies[op]);
+    }
+
+    printf("\nreplayed %zu ops (%zu skipped)\n", total, skipped);
+    cgcs_bench_report("replay (time inside slist calls)", replayed_ns, total);
+    cgcs_bench_report("recorded (wall time between ops)", recorded_ns, total + skipped);
+    printf("throughput: %.3f Mops/s\n",
+           replayed_ns ? (double)(total) * 1e3 / (double)(replayed_ns) : 0.0);
+
+    return EXIT_SUCCESS;
+}
+
+#ifdef CGCS_SLIST_TRACE
+static int cmp_long(const void *lhs, const void *rhs) {
+    return (*(long *)(lhs) > *(long *)(rhs)) - (*(long *)(lhs) < *(long *)(rhs));
+}
+
+static bool is_even_long(const void *arg) { return *(long *)(arg) % 2 == 0; }
+#endif
+
+// Records a pseudo-random mix of operations over a few lists.
+static int generate(const char *path, long count) {
+#ifndef CGCS_SLIST_TRACE
+    fprintf(stderr, "cgcs_slist_replay: -g requires a library built with CGCS_SLIST_TRACE\n");
+    return EXIT_FAILURE;
+#else
+    enum { LIST_COUNT = 4 };
+    slist_t lists[LIST_COUNT] = {
+        CGCS_SLIST_INITIALIZER, CGCS_SLIST_INITIALIZER,
+        CGCS_SLIST_INITIALIZER, CGCS_SLIST_INITIALIZER
+    };
+
+    if (!slist_trace_open(path)) {
+        fprintf(stderr, "cgcs_slist_replay: cannot write trace '%s'\n", path);
+        return EXIT_FAILURE;
+    }
+
+    srand(1);
+
+    for (long i = 0; i < count; i++) {
+        slist_t *sl = &lists[rand() % LIST_COUNT];
+        slist_iterator_t it = slist_before_begin(sl);
+        long value = rand() % 1024;  // fills m_data
+        int roll = rand() % 100;
+
+        // A random position within the first 64 nodes.
+        for (int steps = rand() % 64; steps > 0 && it->m_next; steps--) {
+            it = it->m_next;
+        }
+
+        if (roll < 35) {
+            slist_push_front(sl, &value);
+        } else if (roll < 55) {
+            slist_insert_after(sl, it, &value);
+        } else if (roll < 70) {
+            slist_pop_front(sl);
+        } else if (roll < 80) {
+            if (it->m_next) {
+                slist_erase_after(sl, it);
+            }
+        } else if (roll < 95) {
+            slist_find(sl, cmp_long, &value);
+        } else if (roll < 97 && it != slist_before_begin(sl)) {
+            // Take (before_begin, it] out, split it, partition the back part,
+            // then splice everything back; scratch lists start out unseen.
+            slist_t front = CGCS_SLIST_INITIALIZER;
+            slist_t back = CGCS_SLIST_INITIALIZER;
+            slist_t evens = CGCS_SLIST_INITIALIZER;
+            slist_t odds = CGCS_SLIST_INITIALIZER;
+
+            slist_splice_after_range(&front, slist_before_begin(&front),
+                                     sl, slist_before_begin(sl), it);
+            slist_split_after(&front, slist_begin(&front), &back);
+            slist_partition(&back, is_even_long, &evens, &odds);
+            slist_splice_after(sl, slist_before_begin(sl), &odds);
+            slist_splice_after(sl, slist_before_begin(sl), &evens);
+            slist_splice_after(sl, slist_before_begin(sl), &front);
+        } else if (it != slist_before_begin(sl)) {
+            slist_t *dst = &lists[rand() % LIST_COUNT];
+            if (dst != sl) {
+                // Move the nodes in (before_begin, it] to the front of dst.
+                slist_node_transfer_after_range(slist_before_begin(dst),
+                                                slist_before_begin(sl), it);
+            }
+        }
+    }
+
+    // Half the lists are torn down a few nodes at a time.
+    for (int i = 0; i < LIST_COUNT; i++) {
+        if (i % 2) {
+            while (slist_deinit_step(&lists[i], 256)) {
+                continue;
+            }
+        } else {
+            slist_deinit(&lists[i]);
+        }
+    }
+
+    slist_trace_close();
+    printf("recorded %ld ops to %s\n", count, path);
+    return EXIT_SUCCESS;
+#endif
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc >= 3 && strcmp(argv[1], "-g") == 0) {
+        return generate(argv[2], argc >= 4 ? atol(argv[3]) : 1000000);
+    }
+
+    if (argc == 4 && strcmp(argv[1], "-a") == 0) {
+        if (strcmp(argv[2], "pool") == 0) {
+            alloc_name = "pool";
+            replay_allocfn = pool_alloc;
+            replay_freefn = pool_free;
+        } else if (strcmp(argv[2], "cache") == 0) {
+            alloc_name = "cache";
+            replay_allocfn = slist_cache_alloc;
+            replay_freefn = slist_cache_free;
+        } else if (strcmp(argv[2], "malloc") != 0) {
+            fprintf(stderr, "cgcs_slist_replay: unknown allocator '%s'\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+
+        return replay(argv[3]);
+    }
+
+    if (argc == 2) {
+        return replay(argv[1]);
+    }
+
+    fprintf(stderr,
+            "usage: %s [-a malloc|pool|cache] trace.bin\n"
+            "       %s -g trace.bin [op-count]\n", argv[0], argv[0]);
+    return EXIT_FAILURE;
+}
@@ -27,9 +27,19 @@ static inline int cmp_int(const void *lhs, const void *rhs) {
     return *(int *)(lhs) - *(int *)(rhs);
 }
 
+// Callback functions for (long) type -- a long fills m_data entirely.
+static inline void print_long(void *arg) { printf(" %ld ", *(long *)(arg)); }
+static inline bool is_even_long(const void *arg) { return *(long *)(arg) % 2 == 0; }
+
 // Sample usage of slist (ints).
 void use_slist_int();
 
+// Sample usage of split/partition/splice (longs).
+void shard_and_merge_longs();
+
+// Sample usage of budgeted traversal/destruction (longs).
+void scan_and_teardown_in_steps();
+
 // Sample usage of slist of dynamically-allocated (char *)
 void add_strings(slist_t *sl);
 void print_slist_strings(slist_t *sl);
@@ -45,6 +55,14 @@ int main(int argc, const char *argv[]) {
     // (or rather, types that do not require storage on the free-store)
     use_slist_int();
 
+    // Split an slist of long in two, partition one half,
+    // then splice everything back together -- no nodes are allocated.
+    shard_and_merge_longs();
+
+    // Visit, then destroy, an slist a few nodes at a time --
+    // as an event loop would between other work.
+    scan_and_teardown_in_steps();
+
     // Initialize an slist.
     slist_t slist_strings = CGCS_SLIST_INITIALIZER;
 
@@ -121,6 +139,67 @@ void use_slist_int() {
     */
 }
 
+void shard_and_merge_longs() {
+    slist_t slist_longs = CGCS_SLIST_INITIALIZER;
+    slist_t back_half = CGCS_SLIST_INITIALIZER;
+    slist_t evens = CGCS_SLIST_INITIALIZER;
+    slist_t odds = CGCS_SLIST_INITIALIZER;
+    slist_t *sl = &slist_longs;
+
+    for (long i = 10; i >= 1; i--) {
+        slist_push_front(sl, &i);
+    }
+
+    // Nodes after the 5th element now belong to back_half.
+    slist_split_after(sl, slist_node_get(slist_begin(sl), 4), &back_half);
+
+    // Every node of back_half is relinked into evens or odds.
+    slist_partition(&back_half, is_even_long, &evens, &odds);
+
+    printf("\n{");
+    slist_foreach(sl, print_long);
+    printf("} evens: {");
+    slist_foreach(&evens, print_long);
+    printf("} odds: {");
+    slist_foreach(&odds, print_long);
+    printf("}\n");
+
+    // Merge: odds go to the front, evens after the last node of sl.
+    slist_splice_after(sl, slist_before_begin(sl), &odds);
+    slist_splice_after(sl, slist_node_get(slist_begin(sl), 6), &evens);
+
+    printf("{");
+    slist_foreach(sl, print_long);
+    printf("}\n");
+
+    slist_deinit(sl);
+}
+
+void scan_and_teardown_in_steps() {
+    slist_t slist_longs = CGCS_SLIST_INITIALIZER;
+    slist_t *sl = &slist_longs;
+    slist_cursor_t cursor;
+    int steps = 0;
+
+    for (long i = 10; i >= 1; i--) {
+        slist_push_front(sl, &i);
+    }
+
+    // At most 4 nodes are visited per call.
+    slist_cursor_init(&cursor, sl);
+    printf("{");
+    while (slist_foreach_step(&cursor, print_long, 4)) {
+        printf("|");
+    }
+    printf("}\n");
+
+    // At most 3 nodes are freed per call.
+    while (slist_deinit_step(sl, 3)) {
+        steps++;
+    }
+    printf("destroyed in %d steps, empty: %s\n", steps + 1, slist_empty(sl) ? "true" : "false");
+}
+
 void add_strings(slist_t *sl) {
     const char *arr[] = {
         "Beta",
@@ -0,0 +1,190 @@
+/*!
+    \file       cgcs_kslist.c
+    \brief      Source file for keyed (fingerprinted) list with chunked storage
+ */
+
+#include "cgcs_kslist.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// Bit i is set when fingerprints[i] == fp, for i in [0, CGCS_KSLIST_CHUNK_SIZE).
+static inline uint32_t
+kslist_match_mask(const uint32_t *fingerprints, uint32_t fp) {
+    uint32_t mask = 0;
+
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32((int)(fp));
+
+    for (int i = 0; i < CGCS_KSLIST_CHUNK_SIZE; i += 8) {
+        const __m256i lanes = _mm256_loadu_si256((const __m256i *)(fingerprints + i));
+        const __m256i eq = _mm256_cmpeq_epi32(lanes, needle);
+        mask |= (uint32_t)(_mm256_movemask_ps(_mm256_castsi256_ps(eq))) << i;
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi32((int)(fp));
+
+    for (int i = 0; i < CGCS_KSLIST_CHUNK_SIZE; i += 4) {
+        const __m128i lanes = _mm_loadu_si128((const __m128i *)(fingerprints + i));
+        const __m128i eq = _mm_cmpeq_epi32(lanes, needle);
+        mask |= (uint32_t)(_mm_movemask_ps(_mm_castsi128_ps(eq))) << i;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint32x4_t needle = vdupq_n_u32(fp);
+
+    for (int i = 0; i < CGCS_KSLIST_CHUNK_SIZE; i += 4) {
+        // Any lane equal? Only then build the per-lane bits.
+        if (vmaxvq_u32(vceqq_u32(vld1q_u32(fingerprints + i), needle))) {
+            for (int j = i; j < i + 4; j++) {
+                mask |= (uint32_t)(fingerprints[j] == fp) << j;
+            }
+        }
+    }
+#else
+    for (int i = 0; i < CGCS_KSLIST_CHUNK_SIZE; i++) {
+        mask |= (uint32_t)(fingerprints[i] == fp) << i;
+    }
+#endif
+
+    return mask;
+}
+
+// Locates the first element equal to data.
+static bool
+kslist_locate(kslist_t *self,
+              const void *data,
+              struct cgcs_kslist_chunk **chunk,
+              int *index) {
+    const uint32_t fp = self->m_hashfn(data);
+
+    for (struct cgcs_kslist_chunk *c = self->m_head; c; c = c->m_next) {
+        uint32_t mask = kslist_match_mask(c->m_fingerprints, fp);
+
+        // Slots at or past m_count hold stale fingerprints.
+        mask &= (uint32_t)((1ull << c->m_count) - 1);
+
+        while (mask) {
+            const int i = __builtin_ctz(mask);
+
+            if (self->m_cmpfn(data, &(c->m_data[i])) == 0) {
+                *chunk = c;
+                *index = i;
+                return true;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    return false;
+}
+
+void kslist_init(kslist_t *self,
+                 uint32_t (*hashfn)(const void *),
+                 int (*cmpfn)(const void *, const void *)) {
+    self->m_head = NULL;
+    self->m_size = 0;
+    self->m_hashfn = hashfn;
+    self->m_cmpfn = cmpfn;
+}
+
+void kslist_deinit(kslist_t *self) {
+    // Destruction of the elements should be handled by the caller
+    // prior to calling this function.
+    while (self->m_head) {
+        struct cgcs_kslist_chunk *victim = self->m_head;
+        self->m_head = victim->m_next;
+        free(victim);
+    }
+
+    self->m_size = 0;
+}
+
+voidptr kslist_insert(kslist_t *self, const void *data) {
+    struct cgcs_kslist_chunk *head = self->m_head;
+
+    if (head == NULL || head->m_count == CGCS_KSLIST_CHUNK_SIZE) {
+        head = malloc(sizeof *head);
+        assert(head);
+
+        head->m_next = self->m_head;
+        head->m_count = 0;
+        self->m_head = head;
+    }
+
+    const size_t i = head->m_count++;
+
+    // data is the address of a (T *), as in slist_node_init.
+    memcpy(&(head->m_data[i]), data, sizeof(void *));
+    head->m_fingerprints[i] = self->m_hashfn(&(head->m_data[i]));
+
+    self->m_size++;
+    return &(head->m_data[i]);
+}
+
+voidptr kslist_find(kslist_t *self, const void *data) {
+    struct cgcs_kslist_chunk *chunk = NULL;
+    int index = 0;
+
+    if (kslist_locate(self, data, &chunk, &index)) {
+        return &(chunk->m_data[index]);
+    }
+
+    return NULL;
+}
+
+bool kslist_erase(kslist_t *self, const void *data) {
+    struct cgcs_kslist_chunk *chunk = NULL;
+    int index = 0;
+
+    if (!kslist_locate(self, data, &chunk, &index)) {
+        return false;
+    }
+
+    // Fill the hole with the head chunk's last element.
+    struct cgcs_kslist_chunk *head = self->m_head;
+    const size_t last = --head->m_count;
+
+    chunk->m_data[index] = head->m_data[last];
+    chunk->m_fingerprints[index] = head->m_fingerprints[last];
+
+    if (head->m_count == 0) {
+        self->m_head = head->m_next;
+        free(head);
+    }
+
+    self->m_size--;
+    return true;
+}
+
+void kslist_foreach(kslist_t *self, void (*func)(void *)) {
+    for (struct cgcs_kslist_chunk *c = self->m_head; c; c = c->m_next) {
+        for (size_t i = 0; i < c->m_count; i++) {
+            func(&(c->m_data[i]));
+        }
+    }
+}
+
+uint32_t kslist_hash_cstr(const void *arg) {
+    uint32_t hash = 2166136261u;
+
+    for (const char *str = *(char **)(arg); *str; str++) {
+        hash ^= (unsigned char)(*str);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+uint32_t kslist_hash_word(const void *arg) {
+    uint64_t word = 0;
+
+    memcpy(&word, arg, sizeof(void *));
+    word ^= word >> 33;
+    word *= 0xff51afd7ed558ccdull;
+    word ^= word >> 33;
+    return (uint32_t)(word);
+}
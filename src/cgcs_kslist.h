@@ -0,0 +1,79 @@
+/*!
+    \file       cgcs_kslist.h
+    \brief      Header file for keyed (fingerprinted) list with chunked storage
+
+    A kslist_t stores elements in a singly linked list of chunks.
+    Alongside each element, a chunk stores a 32-bit fingerprint:
+    hashfn(&element). kslist_find hashes the key once, compares it against
+    all fingerprints of a chunk at once (AVX2/SSE2/NEON, or scalar),
+    and calls cmpfn only where the fingerprints match.
+
+    hashfn and cmpfn take the address of an element (a (T *)),
+    as with slist_find; equal elements must have equal fingerprints.
+    Elements are pointer-sized, as with slist_t.
+
+    kslist_erase moves the front element into the erased slot,
+    so iteration order is not preserved across erasures.
+ */
+
+#ifndef CGCS_KSLIST_H
+#define CGCS_KSLIST_H
+
+#include "cgcs_slist.h"
+
+#include <stdint.h>
+
+#define CGCS_KSLIST_CHUNK_SIZE 16
+
+struct cgcs_kslist_chunk {
+    uint32_t m_fingerprints[CGCS_KSLIST_CHUNK_SIZE];
+    voidptr m_data[CGCS_KSLIST_CHUNK_SIZE];
+    struct cgcs_kslist_chunk *m_next;
+    size_t m_count;
+};
+
+typedef struct cgcs_kslist kslist_t;
+
+struct cgcs_kslist {
+    struct cgcs_kslist_chunk *m_head;  // only the head chunk may be partially filled
+    size_t m_size;
+    uint32_t (*m_hashfn)(const void *);
+    int (*m_cmpfn)(const void *, const void *);
+};
+
+void kslist_init(kslist_t *self,
+                 uint32_t (*hashfn)(const void *),
+                 int (*cmpfn)(const void *, const void *));
+
+void kslist_deinit(kslist_t *self);
+
+static size_t kslist_size(kslist_t *self);
+static bool kslist_empty(kslist_t *self);
+
+// data is the address of a (T); returns the address of the stored (T).
+voidptr kslist_insert(kslist_t *self, const void *data);
+
+// Returns the address of the first stored (T) equal to data, or NULL.
+voidptr kslist_find(kslist_t *self, const void *data);
+
+// Erases the first element equal to data. Returns false if there is none.
+bool kslist_erase(kslist_t *self, const void *data);
+
+void kslist_foreach(kslist_t *self, void (*func)(void *));
+
+// Fingerprint helpers: FNV-1a over a (char *)'s characters,
+// and a mix of a pointer-sized value's bits.
+uint32_t kslist_hash_cstr(const void *arg);
+uint32_t kslist_hash_word(const void *arg);
+
+static inline size_t
+kslist_size(kslist_t *self) {
+    return self->m_size;
+}
+
+static inline bool
+kslist_empty(kslist_t *self) {
+    return self->m_size == 0;
+}
+
+#endif /* CGCS_KSLIST_H */
@@ -0,0 +1,240 @@
+/*!
+    \file       cgcs_skiplist.c
+    \brief      Source file for sorted skip list built on cgcs_slist nodes
+ */
+
+#include "cgcs_skiplist.h"
+
+// A NULL node stands for the head (self->m_list.m_impl, self->m_forward).
+static inline struct cgcs_skiplist_node *
+skiplist_next(skiplist_t *self, struct cgcs_skiplist_node *x, int level) {
+    if (level == 0) {
+        struct cgcs_slist_node *next = x ? x->m_base.m_next : self->m_list.m_impl.m_next;
+        return (struct cgcs_skiplist_node *)(next);
+    }
+
+    return x ? x->m_forward[level - 1] : self->m_forward[level - 1];
+}
+
+static inline void
+skiplist_set_next(skiplist_t *self,
+                  struct cgcs_skiplist_node *x,
+                  int level,
+                  struct cgcs_skiplist_node *next) {
+    if (level == 0) {
+        struct cgcs_slist_node *base = next ? &(next->m_base) : NULL;
+
+        if (x) {
+            x->m_base.m_next = base;
+        } else {
+            self->m_list.m_impl.m_next = base;
+        }
+    } else if (x) {
+        x->m_forward[level - 1] = next;
+    } else {
+        self->m_forward[level - 1] = next;
+    }
+}
+
+// Each level is kept with probability 1/4 (xorshift64*).
+static inline int
+skiplist_random_height(skiplist_t *self) {
+    int height = 1;
+
+    self->m_seed ^= self->m_seed >> 12;
+    self->m_seed ^= self->m_seed << 25;
+    self->m_seed ^= self->m_seed >> 27;
+
+    uint64_t bits = self->m_seed * 0x2545f4914f6cdd1dull;
+    while ((bits & 3) == 0 && height < CGCS_SKIPLIST_MAX_LEVEL) {
+        height++;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+// Fills update[level] with the last node (NULL: head) at each level
+// whose element precedes data. With inclusive, elements equal to data
+// also precede it (so insertions go after them).
+static inline struct cgcs_skiplist_node *
+skiplist_search(skiplist_t *self,
+                const void *data,
+                bool inclusive,
+                struct cgcs_skiplist_node **update) {
+    struct cgcs_skiplist_node *x = NULL;
+
+    for (int level = self->m_level - 1; level >= 0; level--) {
+        struct cgcs_skiplist_node *next = NULL;
+
+        while ((next = skiplist_next(self, x, level))) {
+            const int cmp = self->m_cmpfn(data, &(next->m_base.m_data));
+
+            if (cmp < 0 || (cmp == 0 && !inclusive)) {
+                break;
+            }
+
+            x = next;
+        }
+
+        if (update) {
+            update[level] = x;
+        }
+    }
+
+    return skiplist_next(self, x, 0);
+}
+
+static struct cgcs_skiplist_node *
+skiplist_node_hook(skiplist_t *self,
+                   struct cgcs_skiplist_node *node,
+                   int height,
+                   const void *data) {
+    struct cgcs_skiplist_node *update[CGCS_SKIPLIST_MAX_LEVEL];
+
+    slist_node_init(&(node->m_base), data);
+    node->m_height = height;
+
+    skiplist_search(self, data, true, update);
+
+    for (int level = self->m_level; level < height; level++) {
+        update[level] = NULL;
+    }
+
+    if (height > self->m_level) {
+        self->m_level = height;
+    }
+
+    for (int level = 0; level < height; level++) {
+        skiplist_set_next(self, node, level, skiplist_next(self, update[level], level));
+        skiplist_set_next(self, update[level], level, node);
+    }
+
+    self->m_size++;
+    return node;
+}
+
+static struct cgcs_skiplist_node *
+skiplist_node_unhook(skiplist_t *self, const void *data) {
+    struct cgcs_skiplist_node *update[CGCS_SKIPLIST_MAX_LEVEL];
+    struct cgcs_skiplist_node *node = skiplist_search(self, data, false, update);
+
+    if (node == NULL || self->m_cmpfn(data, &(node->m_base.m_data)) != 0) {
+        return NULL;
+    }
+
+    for (int level = 0; level < node->m_height; level++) {
+        skiplist_set_next(self, update[level], level, skiplist_next(self, node, level));
+    }
+
+    while (self->m_level > 1 && self->m_forward[self->m_level - 2] == NULL) {
+        self->m_level--;
+    }
+
+    self->m_size--;
+    return node;
+}
+
+static inline size_t
+skiplist_node_size(int height) {
+    return sizeof(struct cgcs_skiplist_node)
+           + sizeof(struct cgcs_skiplist_node *) * (size_t)(height - 1);
+}
+
+void skiplist_init(skiplist_t *self, int (*cmpfn)(const void *, const void *)) {
+    slist_init(&(self->m_list));
+    memset(self->m_forward, 0, sizeof self->m_forward);
+    self->m_level = 1;
+    self->m_size = 0;
+    self->m_seed = 0x9e3779b97f4a7c15ull ^ (uint64_t)(uintptr_t)(self);
+    self->m_cmpfn = cmpfn;
+}
+
+void skiplist_deinit(skiplist_t *self) {
+    // The bottom level links every node.
+    while (!slist_empty(&(self->m_list))) {
+        slist_iterator_t victim = slist_begin(&(self->m_list));
+        slist_node_unhook_after(slist_before_begin(&(self->m_list)));
+        free(victim);
+    }
+
+    skiplist_init(self, self->m_cmpfn);
+}
+
+void skiplist_deinit_free_fn(skiplist_t *self, void (*freefn)(void *)) {
+    while (!slist_empty(&(self->m_list))) {
+        slist_iterator_t victim = slist_begin(&(self->m_list));
+        slist_node_unhook_after(slist_before_begin(&(self->m_list)));
+        freefn(victim);
+    }
+
+    skiplist_init(self, self->m_cmpfn);
+}
+
+slist_iterator_t skiplist_insert(skiplist_t *self, const void *data) {
+    const int height = skiplist_random_height(self);
+    struct cgcs_skiplist_node *node = malloc(skiplist_node_size(height));
+    assert(node);
+
+    return &(skiplist_node_hook(self, node, height, data)->m_base);
+}
+
+slist_iterator_t skiplist_insert_alloc_fn(skiplist_t *self,
+                                          const void *data,
+                                          void *(*allocfn)(size_t)) {
+    const int height = skiplist_random_height(self);
+    struct cgcs_skiplist_node *node = allocfn(skiplist_node_size(height));
+    assert(node);
+
+    return &(skiplist_node_hook(self, node, height, data)->m_base);
+}
+
+bool skiplist_erase(skiplist_t *self, const void *data) {
+    struct cgcs_skiplist_node *node = skiplist_node_unhook(self, data);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    free(node);
+    return true;
+}
+
+bool skiplist_erase_free_fn(skiplist_t *self,
+                            const void *data,
+                            void (*freefn)(void *)) {
+    struct cgcs_skiplist_node *node = skiplist_node_unhook(self, data);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    freefn(node);
+    return true;
+}
+
+slist_iterator_t skiplist_lower_bound(skiplist_t *self, const void *data) {
+    struct cgcs_skiplist_node *node = skiplist_search(self, data, false, NULL);
+    return node ? &(node->m_base) : skiplist_end(self);
+}
+
+slist_iterator_t skiplist_find(skiplist_t *self, const void *data) {
+    slist_iterator_t it = skiplist_lower_bound(self, data);
+
+    if (it != skiplist_end(self) && self->m_cmpfn(data, &(it->m_data)) == 0) {
+        return it;
+    }
+
+    return skiplist_end(self);
+}
+
+void skiplist_foreach_range(skiplist_t *self,
+                            void (*func)(void *),
+                            const void *lo,
+                            const void *hi) {
+    for (slist_iterator_t it = skiplist_lower_bound(self, lo);
+         it != skiplist_end(self) && self->m_cmpfn(hi, &(it->m_data)) > 0;
+         it = it->m_next) {
+        func(&(it->m_data));
+    }
+}
@@ -0,0 +1,104 @@
+/*!
+    \file       cgcs_skiplist.h
+    \brief      Header file for sorted skip list built on cgcs_slist nodes
+
+    Elements are kept in the order given by cmpfn, which has the same
+    type and calling convention as the cmpfn of slist_find:
+    cmpfn(data, &(it->m_data)), where data is the address of a (T).
+
+    Every node begins with a struct cgcs_slist_node, and the bottom
+    level is an ordinary slist chain -- skiplist_as_slist returns an
+    slist_t that slist_foreach, slist_find, etc. can walk.
+    Do not insert or erase through that slist_t; the upper levels
+    would no longer be consistent.
+ */
+
+#ifndef CGCS_SKIPLIST_H
+#define CGCS_SKIPLIST_H
+
+#include "cgcs_slist.h"
+
+#include <stdint.h>
+
+#define CGCS_SKIPLIST_MAX_LEVEL 32
+
+struct cgcs_skiplist_node {
+    struct cgcs_slist_node m_base;  // level 0: m_data, m_next
+    int m_height;
+    struct cgcs_skiplist_node *m_forward[];  // levels [1, m_height)
+};
+
+typedef struct cgcs_skiplist skiplist_t;
+
+struct cgcs_skiplist {
+    slist_t m_list;  // level 0; its m_impl is the head node
+    struct cgcs_skiplist_node *m_forward[CGCS_SKIPLIST_MAX_LEVEL - 1];
+    int m_level;
+    size_t m_size;
+    uint64_t m_seed;
+    int (*m_cmpfn)(const void *, const void *);
+};
+
+void skiplist_init(skiplist_t *self, int (*cmpfn)(const void *, const void *));
+
+void skiplist_deinit(skiplist_t *self);
+void skiplist_deinit_free_fn(skiplist_t *self, void (*freefn)(void *));
+
+static size_t skiplist_size(skiplist_t *self);
+static bool skiplist_empty(skiplist_t *self);
+
+static slist_t *skiplist_as_slist(skiplist_t *self);
+static slist_iterator_t skiplist_begin(skiplist_t *self);
+static slist_iterator_t skiplist_end(skiplist_t *self);
+
+// Inserts after any elements that compare equal. O(log n) expected.
+slist_iterator_t skiplist_insert(skiplist_t *self, const void *data);
+slist_iterator_t skiplist_insert_alloc_fn(skiplist_t *self,
+                                          const void *data,
+                                          void *(*allocfn)(size_t));
+
+// Erases the first element that compares equal to data.
+// Returns false if there is none.
+bool skiplist_erase(skiplist_t *self, const void *data);
+bool skiplist_erase_free_fn(skiplist_t *self,
+                            const void *data,
+                            void (*freefn)(void *));
+
+// First element not less than data, or skiplist_end.
+slist_iterator_t skiplist_lower_bound(skiplist_t *self, const void *data);
+
+// First element that compares equal to data, or skiplist_end.
+slist_iterator_t skiplist_find(skiplist_t *self, const void *data);
+
+// Invokes func(&(it->m_data)) for each element in [lo, hi).
+void skiplist_foreach_range(skiplist_t *self,
+                            void (*func)(void *),
+                            const void *lo,
+                            const void *hi);
+
+static inline size_t
+skiplist_size(skiplist_t *self) {
+    return self->m_size;
+}
+
+static inline bool
+skiplist_empty(skiplist_t *self) {
+    return self->m_size == 0;
+}
+
+static inline slist_t *
+skiplist_as_slist(skiplist_t *self) {
+    return &(self->m_list);
+}
+
+static inline slist_iterator_t
+skiplist_begin(skiplist_t *self) {
+    return slist_begin(&(self->m_list));
+}
+
+static inline slist_iterator_t
+skiplist_end(skiplist_t *self) {
+    return slist_end(&(self->m_list));
+}
+
+#endif /* CGCS_SKIPLIST_H */
@@ -10,9 +10,17 @@
 
 #include "cgcs_slist.h"
 
-#include <stdio.h>
-
-struct cgcs_slist_node *
+// With CGCS_SLIST_HEADER_ONLY, this file is included by cgcs_slist.h:
+// private macros are #undef'd at the end, private helpers use a cgcs_ prefix.
+#ifdef CGCS_SLIST_TRACE
+#include "cgcs_slist_trace.h"
+#define CGCS_SLIST_RECORD(op, self, arg, result) \
+    slist_trace_record(CGCS_SLIST_TRACE_##op, (self), (arg), (result))
+#else
+#define CGCS_SLIST_RECORD(op, self, arg, result) ((void)(0))
+#endif
+
+CGCS_SLIST_API struct cgcs_slist_node *
 slist_node_new(const void *data) {
     struct cgcs_slist_node *new_node = malloc(sizeof *new_node);
     assert(new_node);
@@ -20,7 +28,7 @@ slist_node_new(const void *data) {
     return new_node;
 }
 
-struct cgcs_slist_node *
+CGCS_SLIST_API struct cgcs_slist_node *
 slist_node_alloc_fn(const void *data, void *(*allocfn)(size_t)) {
     struct cgcs_slist_node *new_node = allocfn(sizeof *new_node);
     assert(new_node);
@@ -28,7 +36,7 @@ slist_node_alloc_fn(const void *data, void *(*allocfn)(size_t)) {
     return new_node;
 }
 
-struct cgcs_slist_node *slist_node_clear_after(struct cgcs_slist_node *x, struct cgcs_slist_node *y) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_clear_after(struct cgcs_slist_node *x, struct cgcs_slist_node *y) {
     while (x->m_next != y) {
         slist_node_erase_after(x);
     }
@@ -36,7 +44,7 @@ struct cgcs_slist_node *slist_node_clear_after(struct cgcs_slist_node *x, struct
     return y;
 }
 
-struct cgcs_slist_node *slist_node_clear_after_free_fn(struct cgcs_slist_node *x, struct cgcs_slist_node *y, void (*freefn)(void *)) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_clear_after_free_fn(struct cgcs_slist_node *x, struct cgcs_slist_node *y, void (*freefn)(void *)) {
     while (x->m_next != y) {
         slist_node_erase_after_freefn(y, freefn);
     }
@@ -44,7 +52,7 @@ struct cgcs_slist_node *slist_node_clear_after_free_fn(struct cgcs_slist_node *x
     return y;
 }
 
-struct cgcs_slist_node *slist_node_find(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (*cmpfn)(const void *, const void *)) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_find(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (*cmpfn)(const void *, const void *)) {
     for (struct cgcs_slist_node *curr = x; curr != y; curr = curr->m_next) {
         if (cmpfn(curr->m_data, data) == 0) {
             return curr;
@@ -54,7 +62,7 @@ struct cgcs_slist_node *slist_node_find(struct cgcs_slist_node *x, struct cgcs_s
     return NULL;
 }
 
-struct cgcs_slist_node *slist_node_find_b(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (^cmp_b)(const void *, const void *)) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_find_b(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (^cmp_b)(const void *, const void *)) {
     for (struct cgcs_slist_node *curr = x; curr != y; curr = curr->m_next) {
         if (cmp_b(curr->m_data, data) == 0) {
             return curr;
@@ -64,7 +72,7 @@ struct cgcs_slist_node *slist_node_find_b(struct cgcs_slist_node *x, struct cgcs
     return NULL;    
 }
 
-struct cgcs_slist_node *slist_node_advance(struct cgcs_slist_node **x, int index) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_advance(struct cgcs_slist_node **x, int index) {
     for (int i = 0; i < index; i++) {
         (*x) = (*x)->m_next;
     }
@@ -72,11 +80,11 @@ struct cgcs_slist_node *slist_node_advance(struct cgcs_slist_node **x, int index
     return (*x);
 }
 
-struct cgcs_slist_node *slist_node_get(struct cgcs_slist_node *x, int index) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_get(struct cgcs_slist_node *x, int index) {
     return slist_node_advance(&x, index);
 }
 
-struct cgcs_slist_node *slist_node_transfer_after(struct cgcs_slist_node *x, struct cgcs_slist_node *start) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_transfer_after(struct cgcs_slist_node *x, struct cgcs_slist_node *start) {
     struct cgcs_slist_node *finish = start->m_next;
     while (finish && finish->m_next) {
         finish = finish->m_next;
@@ -85,7 +93,7 @@ struct cgcs_slist_node *slist_node_transfer_after(struct cgcs_slist_node *x, str
     return slist_node_transfer_after_range(x, start, finish);
 }
 
-struct cgcs_slist_node *slist_node_transfer_after_range(struct cgcs_slist_node *x, struct cgcs_slist_node *start, struct cgcs_slist_node *finish) {
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_transfer_after_range(struct cgcs_slist_node *x, struct cgcs_slist_node *start, struct cgcs_slist_node *finish) {
     struct cgcs_slist_node *keep = start->m_next;
 
     if (finish) {
@@ -96,10 +104,12 @@ struct cgcs_slist_node *slist_node_transfer_after_range(struct cgcs_slist_node *
     }
 
     x->m_next = keep;
+
+    CGCS_SLIST_RECORD(TRANSFER, x, start, finish);
     return finish;
 }
 
-void cgcs_snreverseaft(struct cgcs_slist_node *x) {
+CGCS_SLIST_API void cgcs_snreverseaft(struct cgcs_slist_node *x) {
     struct cgcs_slist_node *tail = x->m_next;
     struct cgcs_slist_node *temp = NULL;
 
@@ -116,32 +126,65 @@ void cgcs_snreverseaft(struct cgcs_slist_node *x) {
     }
 }
 
-void slist_deinit(slist_t *self) {
-    slist_iterator_t it = slist_before_begin(self);
+CGCS_SLIST_API void slist_deinit(slist_t *self) {
+    CGCS_SLIST_RECORD(DEINIT, self, NULL, NULL);
 
-    while (it != slist_end(self)) {
-        it = slist_erase_after(self, it);
+    // Node-level erasure, so the trace holds one DEINIT record
+    // rather than one ERASE_AFTER per node.
+    while (!slist_empty(self)) {
+        slist_node_erase_after(slist_before_begin(self));
     }
 }
 
-void slist_deinit_free_fn(slist_t *self, void (*freefn)(void *)) {
-    slist_iterator_t it = slist_before_begin(self);
+CGCS_SLIST_API void slist_deinit_free_fn(slist_t *self, void (*freefn)(void *)) {
+    CGCS_SLIST_RECORD(DEINIT, self, NULL, NULL);
 
-    while (it != slist_end(self)) {
-        it = slist_erase_after_free_fn(self, it, freefn);
+    while (!slist_empty(self)) {
+        slist_node_erase_after_freefn(slist_before_begin(self), freefn);
+    }
+}
+
+CGCS_SLIST_API bool slist_deinit_step(slist_t *self, size_t budget) {
+    // Every step is recorded with its budget, so a replay
+    // frees the same nodes at the same point.
+    CGCS_SLIST_RECORD(DEINIT_STEP, self, (const void *)(uintptr_t)(budget), NULL);
+
+    while (budget-- > 0 && !slist_empty(self)) {
+        slist_node_erase_after(slist_before_begin(self));
     }
+
+    return !slist_empty(self);
 }
 
-slist_iterator_t 
+CGCS_SLIST_API bool slist_deinit_step_free_fn(slist_t *self,
+                                              size_t budget,
+                                              void (*freefn)(void *)) {
+    CGCS_SLIST_RECORD(DEINIT_STEP, self, (const void *)(uintptr_t)(budget), NULL);
+
+    while (budget-- > 0 && !slist_empty(self)) {
+        slist_node_erase_after_freefn(slist_before_begin(self), freefn);
+    }
+
+    return !slist_empty(self);
+}
+
+CGCS_SLIST_API slist_iterator_t 
 slist_insert_after(slist_t *self,
                  slist_iterator_t it,
                  const void *data) {
     struct cgcs_slist_node *new_node = slist_node_new(data);
     slist_node_hook_after(new_node, it);
+
+    if (it == slist_before_begin(self)) {
+        CGCS_SLIST_RECORD(PUSH_FRONT, self, it, new_node);
+    } else {
+        CGCS_SLIST_RECORD(INSERT_AFTER, self, it, new_node);
+    }
+
     return it->m_next;
 }
 
-slist_iterator_t
+CGCS_SLIST_API slist_iterator_t
 slist_insert_after_alloc_fn(slist_t *self,
                          slist_iterator_t it,
                          const void *data,
@@ -151,15 +194,27 @@ slist_insert_after_alloc_fn(slist_t *self,
     // new_node->m_next == it->m_next
     // it->m_next == new_node
 
+    if (it == slist_before_begin(self)) {
+        CGCS_SLIST_RECORD(PUSH_FRONT, self, it, new_node);
+    } else {
+        CGCS_SLIST_RECORD(INSERT_AFTER, self, it, new_node);
+    }
+
     return it->m_next;
 }
 
-slist_iterator_t
+CGCS_SLIST_API slist_iterator_t
 slist_erase_after(slist_t *self, slist_iterator_t it) {
     if (slist_empty(self)) {
         return slist_end(self);
     }
 
+    if (it == slist_before_begin(self)) {
+        CGCS_SLIST_RECORD(POP_FRONT, self, it, NULL);
+    } else {
+        CGCS_SLIST_RECORD(ERASE_AFTER, self, it, NULL);
+    }
+
     slist_iterator_t old_node = it->m_next;
 
     slist_node_unhook_after(it);
@@ -169,7 +224,7 @@ slist_erase_after(slist_t *self, slist_iterator_t it) {
     return it->m_next;
 }
 
-slist_iterator_t
+CGCS_SLIST_API slist_iterator_t
 slist_erase_after_free_fn(slist_t *self,
                        slist_iterator_t it,
                        void (*freefn)(void *)) {
@@ -177,14 +232,22 @@ slist_erase_after_free_fn(slist_t *self,
         return slist_end(self);
     }
 
+    if (it == slist_before_begin(self)) {
+        CGCS_SLIST_RECORD(POP_FRONT, self, it, NULL);
+    } else {
+        CGCS_SLIST_RECORD(ERASE_AFTER, self, it, NULL);
+    }
+
+    slist_iterator_t old_node = it->m_next;
+
     slist_node_unhook_after(it);
     // it->m_next == it->m_next->m_next == old_node->m_next
-    slist_node_free_fn(it, freefn);
+    slist_node_free_fn(old_node, freefn);
 
     return it->m_next;
 }
 
-void slist_foreach(slist_t *self, void (*func)(void *)) {
+CGCS_SLIST_API void slist_foreach(slist_t *self, void (*func)(void *)) {
     for (slist_iterator_t it = slist_begin(self);
          it != slist_end(self);
          it = it->m_next) {
@@ -192,7 +255,7 @@ void slist_foreach(slist_t *self, void (*func)(void *)) {
     }
 }
 
-void slist_foreach_range(slist_t *self, void (*func)(void *),
+CGCS_SLIST_API void slist_foreach_range(slist_t *self, void (*func)(void *),
                           slist_iterator_t beg,
                           slist_iterator_t end) {
     for (slist_iterator_t it = beg;
@@ -202,35 +265,53 @@ void slist_foreach_range(slist_t *self, void (*func)(void *),
     }
 }
 
-slist_iterator_t slist_find(slist_t *self,
+CGCS_SLIST_API bool slist_foreach_step(slist_cursor_t *cursor,
+                                       void (*func)(void *),
+                                       size_t budget) {
+    slist_iterator_t it = cursor->m_pos;
+
+    for (; budget > 0 && it != cursor->m_end; budget--) {
+        func(&(it->m_data));
+        it = it->m_next;
+    }
+
+    cursor->m_pos = it;
+    return !slist_cursor_done(cursor);
+}
+
+CGCS_SLIST_API slist_iterator_t slist_find(slist_t *self,
                                 int (*cmpfn)(const void *, const void *),
                                 const void *data) {
     for (slist_iterator_t it = slist_begin(self);
          it != slist_end(self);
          it = it->m_next) {
         if (cmpfn(data, &(it->m_data)) == 0) {
+            CGCS_SLIST_RECORD(FIND, self, slist_begin(self), it);
             return it;
         }
     }
-    
+
+    CGCS_SLIST_RECORD(FIND, self, slist_begin(self), NULL);
     return slist_end(self);
 }
 
-slist_iterator_t slist_find_b(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_b(slist_t *self,
                                   int (^cmp_b)(const void *, const void *),
                               const void *data) {
     for (slist_iterator_t it = slist_begin(self);
          it != slist_end(self);
          it = it->m_next) {
         if (cmp_b(data, &(it->m_data)) == 0) {
+            CGCS_SLIST_RECORD(FIND, self, slist_begin(self), it);
             return it;
         }
     }
-    
+
+    CGCS_SLIST_RECORD(FIND, self, slist_begin(self), NULL);
     return slist_end(self);
 }
 
-slist_iterator_t slist_find_range(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_range(slist_t *self,
                                       int (*cmpfn)(const void *, const void *),
                                       const void *data,
                                       slist_iterator_t beg,
@@ -239,14 +320,16 @@ slist_iterator_t slist_find_range(slist_t *self,
          it != end;
          it = it->m_next) {
         if (cmpfn(data, &(it->m_data)) == 0) {
+            CGCS_SLIST_RECORD(FIND, self, beg, it);
             return it;
         }
     }
-    
+
+    CGCS_SLIST_RECORD(FIND, self, beg, NULL);
     return slist_end(self);
 }
 
-slist_iterator_t slist_find_range_b(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_range_b(slist_t *self,
                                         int (^cmp_b)(const void *, const void *),
                                         const void *data,
                                         slist_iterator_t beg,
@@ -255,14 +338,146 @@ slist_iterator_t slist_find_range_b(slist_t *self,
          it != end;
          it = it->m_next) {
         if (cmp_b(data, &(it->m_data)) == 0) {
+            CGCS_SLIST_RECORD(FIND, self, beg, it);
             return it;
         }
     }
-    
+
+    CGCS_SLIST_RECORD(FIND, self, beg, NULL);
     return slist_end(self);
 }
 
-slist_t *slist_new() {
+CGCS_SLIST_API void slist_split_after(slist_t *self,
+                                      slist_iterator_t it,
+                                      slist_t *out) {
+    if (slist_empty(out)) {
+        // With finish == NULL, the whole chain after it is moved:
+        // it->m_next becomes NULL, out's before_begin now leads the chain.
+        slist_node_transfer_after_range(slist_before_begin(out), it, NULL);
+        return;
+    }
+
+    // out keeps its nodes, after the moved ones; that needs the last node.
+    slist_iterator_t last = it;
+
+    while (last->m_next != slist_end(self)) {
+        last = last->m_next;
+    }
+
+    if (last != it) {
+        slist_node_transfer_after_range(slist_before_begin(out), it, last);
+    }
+}
+
+CGCS_SLIST_API void slist_splice_after(slist_t *self,
+                                       slist_iterator_t pos,
+                                       slist_t *other) {
+    slist_iterator_t last = slist_before_begin(other);
+
+    while (last->m_next != slist_end(other)) {
+        last = last->m_next;
+    }
+
+    slist_splice_after_range(self, pos, other, slist_before_begin(other), last);
+}
+
+CGCS_SLIST_API void slist_splice_after_range(slist_t *self,
+                                             slist_iterator_t pos,
+                                             slist_t *other,
+                                             slist_iterator_t before_first,
+                                             slist_iterator_t last) {
+    if (before_first == last) {
+        // Empty range; slist_node_transfer_after_range
+        // would otherwise corrupt before_first's link.
+        return;
+    }
+
+    slist_node_transfer_after_range(pos, before_first, last);
+}
+
+// Partition helper: chains [head, tail] hold the nodes moved so far.
+// The chain is linked in front of out's existing nodes once complete.
+static inline void
+cgcs_slist_partition_link(slist_t *out,
+                     slist_iterator_t head,
+                     slist_iterator_t tail) {
+    if (head) {
+        tail->m_next = slist_begin(out);
+        out->m_impl.m_next = head;
+    }
+}
+
+CGCS_SLIST_API void slist_partition(slist_t *self,
+                                    bool (*pred)(const void *),
+                                    slist_t *out_true,
+                                    slist_t *out_false) {
+    slist_iterator_t heads[2] = { NULL, NULL };
+    slist_iterator_t tails[2] = { NULL, NULL };
+    slist_iterator_t it = slist_begin(self);
+
+    while (it != slist_end(self)) {
+        slist_iterator_t next = it->m_next;
+        const int which = pred(&(it->m_data)) ? 1 : 0;
+
+        // Replayed as moving it, self's first node by then, after
+        // the last node moved to the same list (or that list's front).
+        CGCS_SLIST_RECORD(TRANSFER,
+                          tails[which] ? tails[which] : slist_before_begin(which ? out_true : out_false),
+                          slist_before_begin(self),
+                          it);
+
+        if (tails[which]) {
+            tails[which]->m_next = it;
+        } else {
+            heads[which] = it;
+        }
+
+        tails[which] = it;
+        it = next;
+    }
+
+    self->m_impl.m_next = slist_end(self);
+
+    cgcs_slist_partition_link(out_true, heads[1], tails[1]);
+    cgcs_slist_partition_link(out_false, heads[0], tails[0]);
+}
+
+CGCS_SLIST_API void slist_partition_b(slist_t *self,
+                                      bool (^pred_b)(const void *),
+                                      slist_t *out_true,
+                                      slist_t *out_false) {
+    slist_iterator_t heads[2] = { NULL, NULL };
+    slist_iterator_t tails[2] = { NULL, NULL };
+    slist_iterator_t it = slist_begin(self);
+
+    while (it != slist_end(self)) {
+        slist_iterator_t next = it->m_next;
+        const int which = pred_b(&(it->m_data)) ? 1 : 0;
+
+        // Replayed as moving it, self's first node by then, after
+        // the last node moved to the same list (or that list's front).
+        CGCS_SLIST_RECORD(TRANSFER,
+                          tails[which] ? tails[which] : slist_before_begin(which ? out_true : out_false),
+                          slist_before_begin(self),
+                          it);
+
+        if (tails[which]) {
+            tails[which]->m_next = it;
+        } else {
+            heads[which] = it;
+        }
+
+        tails[which] = it;
+        it = next;
+    }
+
+    self->m_impl.m_next = slist_end(self);
+
+    cgcs_slist_partition_link(out_true, heads[1], tails[1]);
+    cgcs_slist_partition_link(out_false, heads[0], tails[0]);
+}
+
+CGCS_SLIST_API slist_t *slist_new() {
     slist_t *sl = malloc(sizeof *sl);
     assert(sl);
 
@@ -270,7 +485,7 @@ slist_t *slist_new() {
     return sl;
 }
 
-slist_t *slist_new_alloc_fn(void *(*allocfn)(size_t)) {
+CGCS_SLIST_API slist_t *slist_new_alloc_fn(void *(*allocfn)(size_t)) {
     slist_t *sl = allocfn(sizeof *sl);
     assert(sl);
 
@@ -278,12 +493,34 @@ slist_t *slist_new_alloc_fn(void *(*allocfn)(size_t)) {
     return sl;
 }
 
-void slist_delete(slist_t *sl) {
+CGCS_SLIST_API void slist_delete(slist_t *sl) {
     slist_deinit(sl);
     free(sl);
 }
 
-void slist_delete_free_fn(slist_t *sl, void (*freefn)(void *)) {
+CGCS_SLIST_API void slist_delete_free_fn(slist_t *sl, void (*freefn)(void *)) {
     slist_deinit_free_fn(sl, freefn);
     freefn(sl);
 }
+
+CGCS_SLIST_API bool slist_delete_step(slist_t *sl, size_t budget) {
+    if (slist_deinit_step(sl, budget)) {
+        return true;
+    }
+
+    free(sl);
+    return false;
+}
+
+CGCS_SLIST_API bool slist_delete_step_free_fn(slist_t *sl,
+                                              size_t budget,
+                                              void (*freefn)(void *)) {
+    if (slist_deinit_step_free_fn(sl, budget, freefn)) {
+        return true;
+    }
+
+    freefn(sl);
+    return false;
+}
+
+#undef CGCS_SLIST_RECORD
@@ -17,6 +17,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Define CGCS_SLIST_HEADER_ONLY to compile the whole library into each
+// including translation unit (see the CGCS_SLIST_HEADER_ONLY CMake option).
+// Every out-of-line function then becomes static inline,
+// so the compiler is free to inline it at the call site.
+#ifdef CGCS_SLIST_HEADER_ONLY
+#define CGCS_SLIST_API static inline
+#else
+#define CGCS_SLIST_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef void *voidptr;
 
 struct cgcs_slist_node {
@@ -32,8 +46,8 @@ static void slist_node_deinit(struct cgcs_slist_node *self);
 static void slist_node_hook_after(struct cgcs_slist_node *self, struct cgcs_slist_node *pos);
 static void slist_node_unhook_after(struct cgcs_slist_node *self);
 
-struct cgcs_slist_node *slist_node_new(const void *data);
-struct cgcs_slist_node *slist_node_alloc_fn(const void *data,
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_new(const void *data);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_alloc_fn(const void *data,
                                           void *(*allocfn)(size_t));
 static void slist_node_delete(struct cgcs_slist_node *node);
 static void slist_node_free_fn(struct cgcs_slist_node *node,
@@ -44,17 +58,17 @@ static struct cgcs_slist_node *slist_node_insert_after_alloc_fn(struct cgcs_slis
 static struct cgcs_slist_node *slist_node_erase_after(struct cgcs_slist_node *x);
 static struct cgcs_slist_node *slist_node_erase_after_freefn(struct cgcs_slist_node *x, void (*freefn)(void *));
 
-struct cgcs_slist_node *slist_node_clear_after(struct cgcs_slist_node *x, struct cgcs_slist_node *y);
-struct cgcs_slist_node *slist_node_clear_after_free_fn(struct cgcs_slist_node *x, struct cgcs_slist_node *y, void (*freefn)(void *));
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_clear_after(struct cgcs_slist_node *x, struct cgcs_slist_node *y);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_clear_after_free_fn(struct cgcs_slist_node *x, struct cgcs_slist_node *y, void (*freefn)(void *));
 
-struct cgcs_slist_node *slist_node_find(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (*cmpfn)(const void *, const void *));
-struct cgcs_slist_node *slist_node_find_b(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (^cmp_b)(const void *, const void *));
-struct cgcs_slist_node *slist_node_advance(struct cgcs_slist_node **x, int index);
-struct cgcs_slist_node *slist_node_get(struct cgcs_slist_node *x, int index);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_find(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (*cmpfn)(const void *, const void *));
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_find_b(struct cgcs_slist_node *x, struct cgcs_slist_node *y, const void *data, int (^cmp_b)(const void *, const void *));
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_advance(struct cgcs_slist_node **x, int index);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_get(struct cgcs_slist_node *x, int index);
 
-struct cgcs_slist_node *slist_node_transfer_after(struct cgcs_slist_node *x, struct cgcs_slist_node *start);
-struct cgcs_slist_node *slist_node_transfer_after_range(struct cgcs_slist_node *x, struct cgcs_slist_node *start, struct cgcs_slist_node *finish);
-void cgcs_snreverseaft(struct cgcs_slist_node *x);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_transfer_after(struct cgcs_slist_node *x, struct cgcs_slist_node *start);
+CGCS_SLIST_API struct cgcs_slist_node *slist_node_transfer_after_range(struct cgcs_slist_node *x, struct cgcs_slist_node *start, struct cgcs_slist_node *finish);
+CGCS_SLIST_API void cgcs_snreverseaft(struct cgcs_slist_node *x);
 
 static inline void
 slist_node_init(struct cgcs_slist_node *self, const void *data) {
@@ -154,10 +168,18 @@ struct cgcs_slist {
 
 static void slist_init(slist_t *self);
 
-void slist_deinit(slist_t *self);
-void slist_deinit_free_fn(slist_t *self,
+CGCS_SLIST_API void slist_deinit(slist_t *self);
+CGCS_SLIST_API void slist_deinit_free_fn(slist_t *self,
                           void (*freefn)(void *));
 
+// Incremental destruction: frees at most budget nodes per call.
+// Returns true while nodes remain, i.e.
+//      while (slist_deinit_step(sl, 1024)) { /* yield to the event loop */ }
+CGCS_SLIST_API bool slist_deinit_step(slist_t *self, size_t budget);
+CGCS_SLIST_API bool slist_deinit_step_free_fn(slist_t *self,
+                                              size_t budget,
+                                              void (*freefn)(void *));
+
 static voidptr slist_front(slist_t *self);
 static bool slist_empty(slist_t *self);
 
@@ -165,19 +187,19 @@ static slist_iterator_t slist_before_begin(slist_t *self);
 static slist_iterator_t slist_begin(slist_t *self);
 static slist_iterator_t slist_end(slist_t *self);
 
-slist_iterator_t slist_insert_after(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_insert_after(slist_t *self,
                                      slist_iterator_t it,
                                      const void *data);
 
-slist_iterator_t slist_insert_after_alloc_fn(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_insert_after_alloc_fn(slist_t *self,
                                              slist_iterator_t it,
                                              const void *data,
                                              void *(*allocfn)(size_t));
 
-slist_iterator_t slist_erase_after(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_erase_after(slist_t *self,
                                     slist_iterator_t it);
 
-slist_iterator_t slist_erase_after_free_fn(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_erase_after_free_fn(slist_t *self,
                                            slist_iterator_t it,
                                            void (*freefn)(void *));
 
@@ -190,37 +212,98 @@ static void slist_push_front_alloc_fn(slist_t *self,
 static void slist_pop_front(slist_t *self);
 static void slist_pop_front_free_fn(slist_t *self, void (*freefn)(void *));
 
-void slist_foreach(slist_t *self, void (*func)(void *));
+CGCS_SLIST_API void slist_foreach(slist_t *self, void (*func)(void *));
 
-void slist_foreach_range(slist_t *self, void (*func)(void *),
+CGCS_SLIST_API void slist_foreach_range(slist_t *self, void (*func)(void *),
                           slist_iterator_t beg,
                           slist_iterator_t end);
 
-slist_iterator_t slist_find(slist_t *self,
+// Resumable traversal of [beg, end).
+// The node a cursor rests on must not be erased between steps.
+typedef struct cgcs_slist_cursor slist_cursor_t;
+
+struct cgcs_slist_cursor {
+    slist_iterator_t m_pos;
+    slist_iterator_t m_end;
+};
+
+static void slist_cursor_init(slist_cursor_t *cursor, slist_t *self);
+static void slist_cursor_init_range(slist_cursor_t *cursor,
+                                    slist_iterator_t beg,
+                                    slist_iterator_t end);
+static bool slist_cursor_done(slist_cursor_t *cursor);
+
+// Invokes func on at most budget nodes, advancing cursor.
+// Returns true while nodes remain.
+CGCS_SLIST_API bool slist_foreach_step(slist_cursor_t *cursor,
+                                       void (*func)(void *),
+                                       size_t budget);
+
+CGCS_SLIST_API slist_iterator_t slist_find(slist_t *self,
                                   int (*cmpfn)(const void *, const void *),
                                   const void *data);
 
-slist_iterator_t slist_find_b(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_b(slist_t *self,
                                   int (^cmp_b)(const void *, const void *),
                                   const void *data);
 
-slist_iterator_t slist_find_range(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_range(slist_t *self,
                                         int (*cmpfn)(const void *, const void *),
                                         const void *data,
                                         slist_iterator_t beg,
                                         slist_iterator_t end);
 
-slist_iterator_t slist_find_range_b(slist_t *self,
+CGCS_SLIST_API slist_iterator_t slist_find_range_b(slist_t *self,
                                         int (^cmp_b)(const void *, const void *),
                                         const void *data,
                                         slist_iterator_t beg,
                                         slist_iterator_t end);
 
-slist_t *slist_new();
-slist_t *slist_new_alloc_fn(void *(*allocfn)(size_t));
-
-void slist_delete(slist_t *sl);
-void slist_delete_free_fn(slist_t *sl, void (*freefn)(void *));
+// Relinking primitives -- none of these allocate.
+//
+// slist_split_after: moves (it, end) to the front of out.
+//      O(1) if out is empty; otherwise O(length of (it, end)), to find its last node.
+// slist_splice_after: moves all of other after pos; other becomes empty.
+//      O(length of other), to find its last node.
+// slist_splice_after_range: moves (before_first, last] from other after pos. O(1).
+// slist_partition: moves every node of self to the front of out_true
+//      or out_false, by pred(&(it->m_data)), keeping their relative order;
+//      self becomes empty. O(n).
+CGCS_SLIST_API void slist_split_after(slist_t *self,
+                                      slist_iterator_t it,
+                                      slist_t *out);
+
+CGCS_SLIST_API void slist_splice_after(slist_t *self,
+                                       slist_iterator_t pos,
+                                       slist_t *other);
+
+CGCS_SLIST_API void slist_splice_after_range(slist_t *self,
+                                             slist_iterator_t pos,
+                                             slist_t *other,
+                                             slist_iterator_t before_first,
+                                             slist_iterator_t last);
+
+CGCS_SLIST_API void slist_partition(slist_t *self,
+                                    bool (*pred)(const void *),
+                                    slist_t *out_true,
+                                    slist_t *out_false);
+
+CGCS_SLIST_API void slist_partition_b(slist_t *self,
+                                      bool (^pred_b)(const void *),
+                                      slist_t *out_true,
+                                      slist_t *out_false);
+
+CGCS_SLIST_API slist_t *slist_new();
+CGCS_SLIST_API slist_t *slist_new_alloc_fn(void *(*allocfn)(size_t));
+
+CGCS_SLIST_API void slist_delete(slist_t *sl);
+CGCS_SLIST_API void slist_delete_free_fn(slist_t *sl, void (*freefn)(void *));
+
+// Like slist_deinit_step; sl itself is freed by the call that returns false.
+CGCS_SLIST_API bool slist_delete_step(slist_t *sl, size_t budget);
+CGCS_SLIST_API bool slist_delete_step_free_fn(slist_t *sl,
+                                              size_t budget,
+                                              void (*freefn)(void *));
 
 static inline void
 slist_init(slist_t *self) {
@@ -274,4 +357,77 @@ slist_pop_front_free_fn(slist_t *self, void (*freefn)(void *)) {
     slist_erase_after_free_fn(self, slist_before_begin(self), freefn);
 }
 
+static inline void
+slist_cursor_init(slist_cursor_t *cursor, slist_t *self) {
+    slist_cursor_init_range(cursor, slist_begin(self), slist_end(self));
+}
+
+static inline void
+slist_cursor_init_range(slist_cursor_t *cursor,
+                        slist_iterator_t beg,
+                        slist_iterator_t end) {
+    cursor->m_pos = beg;
+    cursor->m_end = end;
+}
+
+static inline bool
+slist_cursor_done(slist_cursor_t *cursor) {
+    return cursor->m_pos == cursor->m_end;
+}
+
+// Specialized traversal functions.
+//
+// slist_foreach/slist_find call func/cmpfn through a function pointer
+// for every node, which the compiler cannot inline across the library boundary.
+// These macros instantiate static inline equivalents with the callback
+// known at compile time, e.g.
+//
+//      static inline int cmp_int(const void *lhs, const void *rhs) { ... }
+//      CGCS_SLIST_DEFINE_FIND(slist_find_int, cmp_int)
+//
+// defines slist_find_int(self, data) and
+// slist_find_int_range(self, data, beg, end), with the same
+// semantics (and argument order to cmpfn) as slist_find/slist_find_range.
+//
+// CGCS_SLIST_DEFINE_FOREACH(slist_foreach_int, func) likewise defines
+// slist_foreach_int(self) and slist_foreach_int_range(self, beg, end).
+
+#define CGCS_SLIST_DEFINE_FIND(name, cmpfn)                                 \
+    static inline slist_iterator_t                                          \
+    name##_range(slist_t *self, const void *data,                           \
+                 slist_iterator_t beg, slist_iterator_t end) {              \
+        for (slist_iterator_t it = beg; it != end; it = it->m_next) {       \
+            if (cmpfn(data, &(it->m_data)) == 0) {                          \
+                return it;                                                  \
+            }                                                               \
+        }                                                                   \
+        return slist_end(self);                                             \
+    }                                                                       \
+                                                                            \
+    static inline slist_iterator_t                                          \
+    name(slist_t *self, const void *data) {                                 \
+        return name##_range(self, data, slist_begin(self), slist_end(self));\
+    }
+
+#define CGCS_SLIST_DEFINE_FOREACH(name, func)                               \
+    static inline void                                                      \
+    name##_range(slist_t *self, slist_iterator_t beg, slist_iterator_t end) {\
+        for (slist_iterator_t it = beg; it != end; it = it->m_next) {       \
+            func(&(it->m_data));                                            \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static inline void                                                      \
+    name(slist_t *self) {                                                   \
+        name##_range(self, slist_begin(self), slist_end(self));             \
+    }
+
+#ifdef CGCS_SLIST_HEADER_ONLY
+#include "cgcs_slist.c"
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* CGCS_LIST_H */
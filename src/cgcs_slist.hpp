@@ -0,0 +1,372 @@
+/*!
+    \file       cgcs_slist.hpp
+    \brief      Header file for typed singly linked list (C++17)
+
+    cgcs::slist<T, Alloc> stores each T inline in its node,
+    supports move-only T, and allocates nodes through Alloc
+    (std::allocator, std::pmr::polymorphic_allocator, or any
+    allocator meeting the standard requirements).
+    Predicates and callbacks are template parameters, so they inline.
+
+    When T is trivially copyable and pointer-sized, a node has the
+    layout of a struct cgcs_slist_node, and c_list() returns an slist_t
+    usable with the C functions that walk or relink nodes
+    (slist_foreach, slist_find, slist_node_transfer_after, ...).
+    C functions that allocate or free nodes must not be used on it,
+    since nodes come from Alloc.
+ */
+
+#ifndef CGCS_SLIST_HPP
+#define CGCS_SLIST_HPP
+
+#ifdef CGCS_SLIST_HEADER_ONLY
+#error "cgcs_slist.hpp requires the compiled cgcs_slist library (CGCS_SLIST_HEADER_ONLY is C-only)"
+#endif
+
+#include "cgcs_slist.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace cgcs {
+
+template <typename T, typename Alloc = std::allocator<T>>
+class slist {
+    struct node {
+        // Not constructed with the node: the before_begin node
+        // never holds a T, and emplace_after constructs it in place.
+        union {
+            T m_data;
+        };
+
+        node *m_next;
+
+        node() : m_next(nullptr) {}
+        ~node() {}
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node>;
+    using node_traits = std::allocator_traits<node_alloc_type>;
+
+    template <bool Const>
+    class basic_iterator {
+        friend class slist;
+        node *m_node;
+
+        explicit basic_iterator(node *n) : m_node(n) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        basic_iterator() : m_node(nullptr) {}
+
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : m_node(it.m_node) {}
+
+        reference operator*() const { return m_node->m_data; }
+        pointer operator->() const { return std::addressof(m_node->m_data); }
+
+        basic_iterator &operator++() {
+            m_node = m_node->m_next;
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator prev = *this;
+            m_node = m_node->m_next;
+            return prev;
+        }
+
+        friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) {
+            return lhs.m_node == rhs.m_node;
+        }
+
+        friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs) {
+            return lhs.m_node != rhs.m_node;
+        }
+    };
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // True when a node has the layout of a struct cgcs_slist_node.
+    static constexpr bool c_layout_compatible =
+        sizeof(T) == sizeof(void *)
+        && alignof(T) <= alignof(void *)
+        && std::is_trivially_copyable<T>::value
+        && std::is_standard_layout<node>::value
+        && sizeof(node) == sizeof(struct cgcs_slist_node);
+
+    slist() : slist(Alloc()) {}
+
+    explicit slist(const Alloc &alloc) : m_alloc(alloc) {}
+
+    // Both delegate first: once the delegated constructor returns,
+    // a throw from emplace_after runs ~slist, freeing the nodes built so far.
+    slist(std::initializer_list<T> values, const Alloc &alloc = Alloc()) : slist(alloc) {
+        iterator pos = before_begin();
+
+        for (const T &value : values) {
+            pos = emplace_after(pos, value);
+        }
+    }
+
+    slist(const slist &other)
+        : slist(Alloc(node_traits::select_on_container_copy_construction(other.m_alloc))) {
+        iterator pos = before_begin();
+
+        for (const T &value : other) {
+            pos = emplace_after(pos, value);
+        }
+    }
+
+    slist(slist &&other) noexcept : m_alloc(std::move(other.m_alloc)) {
+        m_head.m_next = other.m_head.m_next;
+        other.m_head.m_next = nullptr;
+    }
+
+    ~slist() { clear(); }
+
+    slist &operator=(const slist &other) {
+        if (this != &other) {
+            clear();
+
+            // Not every allocator is assignable (std::pmr::polymorphic_allocator).
+            if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+                m_alloc = other.m_alloc;
+            }
+
+            iterator pos = before_begin();
+            for (const T &value : other) {
+                pos = emplace_after(pos, value);
+            }
+        }
+
+        return *this;
+    }
+
+    slist &operator=(slist &&other) noexcept(
+        node_traits::propagate_on_container_move_assignment::value
+        || node_traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        } else if constexpr (node_traits::is_always_equal::value) {
+            steal(other);
+        } else if (m_alloc == other.m_alloc) {
+            steal(other);
+        } else {
+            // Different memory source: move the elements one by one.
+            iterator pos = before_begin();
+            for (T &value : other) {
+                pos = emplace_after(pos, std::move(value));
+            }
+
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+    iterator before_begin() { return iterator(&m_head); }
+    const_iterator before_begin() const { return const_iterator(const_cast<node *>(&m_head)); }
+    const_iterator cbefore_begin() const { return before_begin(); }
+
+    iterator begin() { return iterator(m_head.m_next); }
+    const_iterator begin() const { return const_iterator(m_head.m_next); }
+    const_iterator cbegin() const { return begin(); }
+
+    iterator end() { return iterator(nullptr); }
+    const_iterator end() const { return const_iterator(nullptr); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return m_head.m_next == nullptr; }
+
+    reference front() { return m_head.m_next->m_data; }
+    const_reference front() const { return m_head.m_next->m_data; }
+
+    template <typename... Args>
+    iterator emplace_after(const_iterator pos, Args &&...args) {
+        node *n = node_new(std::forward<Args>(args)...);
+
+        n->m_next = pos.m_node->m_next;
+        pos.m_node->m_next = n;
+        return iterator(n);
+    }
+
+    iterator insert_after(const_iterator pos, const T &value) { return emplace_after(pos, value); }
+    iterator insert_after(const_iterator pos, T &&value) { return emplace_after(pos, std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_front(Args &&...args) {
+        return *emplace_after(before_begin(), std::forward<Args>(args)...);
+    }
+
+    void push_front(const T &value) { emplace_after(before_begin(), value); }
+    void push_front(T &&value) { emplace_after(before_begin(), std::move(value)); }
+
+    // Returns an iterator to the node after the erased one.
+    iterator erase_after(const_iterator pos) {
+        node *victim = pos.m_node->m_next;
+
+        pos.m_node->m_next = victim->m_next;
+        node_delete(victim);
+        return iterator(pos.m_node->m_next);
+    }
+
+    void pop_front() { erase_after(before_begin()); }
+
+    void clear() {
+        while (!empty()) {
+            pop_front();
+        }
+    }
+
+    // Moves all nodes of other after pos. Allocators must compare equal.
+    void splice_after(const_iterator pos, slist &other) {
+        node *first = other.m_head.m_next;
+        node *last = first;
+
+        if (first == nullptr) {
+            return;
+        }
+
+        while (last->m_next) {
+            last = last->m_next;
+        }
+
+        last->m_next = pos.m_node->m_next;
+        pos.m_node->m_next = first;
+        other.m_head.m_next = nullptr;
+    }
+
+    template <typename Pred>
+    iterator find_if(Pred pred) {
+        for (iterator it = begin(); it != end(); ++it) {
+            if (pred(*it)) {
+                return it;
+            }
+        }
+
+        return end();
+    }
+
+    template <typename U>
+    iterator find(const U &value) {
+        return find_if([&value](const T &elem) { return elem == value; });
+    }
+
+    template <typename Func>
+    void foreach(Func func) {
+        for (T &value : *this) {
+            func(value);
+        }
+    }
+
+    // Erases every element for which pred is true; returns how many.
+    template <typename Pred>
+    size_type remove_if(Pred pred) {
+        size_type removed = 0;
+        iterator prev = before_begin();
+
+        while (prev.m_node->m_next) {
+            if (pred(prev.m_node->m_next->m_data)) {
+                erase_after(prev);
+                removed++;
+            } else {
+                ++prev;
+            }
+        }
+
+        return removed;
+    }
+
+    // C interoperability -- see the file comment.
+    template <bool C = c_layout_compatible, typename = std::enable_if_t<C>>
+    slist_t *c_list() {
+        return reinterpret_cast<slist_t *>(&m_head);
+    }
+
+    template <bool C = c_layout_compatible, typename = std::enable_if_t<C>>
+    static slist_iterator_t c_iterator(const_iterator it) {
+        return reinterpret_cast<slist_iterator_t>(it.m_node);
+    }
+
+    template <bool C = c_layout_compatible, typename = std::enable_if_t<C>>
+    static iterator from_c_iterator(slist_iterator_t it) {
+        return iterator(reinterpret_cast<node *>(it));
+    }
+
+private:
+    template <typename... Args>
+    node *node_new(Args &&...args) {
+        node *n = node_traits::allocate(m_alloc, 1);
+        ::new (static_cast<void *>(n)) node();
+
+        try {
+            node_traits::construct(m_alloc, std::addressof(n->m_data), std::forward<Args>(args)...);
+        } catch (...) {
+            n->~node();
+            node_traits::deallocate(m_alloc, n, 1);
+            throw;
+        }
+
+        return n;
+    }
+
+    // Same memory source: takes other's chain as is.
+    void steal(slist &other) {
+        m_head.m_next = other.m_head.m_next;
+        other.m_head.m_next = nullptr;
+    }
+
+    void node_delete(node *n) {
+        node_traits::destroy(m_alloc, std::addressof(n->m_data));
+        n->~node();
+        node_traits::deallocate(m_alloc, n, 1);
+    }
+
+    node m_head;  // before_begin; its m_data is never constructed
+    node_alloc_type m_alloc;
+};
+
+#if defined(__cpp_lib_memory_resource)
+namespace pmr {
+
+template <typename T>
+using slist = cgcs::slist<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+#endif
+
+} // namespace cgcs
+
+#endif /* CGCS_SLIST_HPP */
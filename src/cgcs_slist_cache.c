@@ -0,0 +1,227 @@
+/*!
+    \file       cgcs_slist_cache.c
+    \brief      Source file for the thread-caching slist node allocator
+ */
+
+#include "cgcs_slist_cache.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef CGCS_SLIST_CACHE_HUGEPAGES
+#include <sys/mman.h>
+#endif
+
+#define MAGAZINE_ROUNDS 64
+#define SLAB_SIZE       ((size_t)(2) << 20) // one 2 MiB huge page
+
+struct magazine {
+    struct magazine *m_next;
+    size_t m_count;
+    void *m_rounds[MAGAZINE_ROUNDS];
+};
+
+struct thread_cache {
+    struct magazine *m_loaded;
+    struct magazine *m_previous;
+    bool m_registered;
+};
+
+// Depot: full and empty magazines, plus the current slab.
+// Everything here is guarded by depot_lock.
+static pthread_mutex_t depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct magazine *depot_full = NULL;
+static struct magazine *depot_empty = NULL;
+static unsigned char *slab_cursor = NULL;
+static size_t slab_remaining = 0;
+
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+
+static _Thread_local struct thread_cache tl_cache = { NULL, NULL, false };
+
+static inline void
+magazine_push(struct magazine **stack, struct magazine *mag) {
+    mag->m_next = *stack;
+    *stack = mag;
+}
+
+static inline struct magazine *
+magazine_pop(struct magazine **stack) {
+    struct magazine *mag = *stack;
+
+    if (mag) {
+        *stack = mag->m_next;
+    }
+
+    return mag;
+}
+
+static unsigned char *
+slab_new(void) {
+    void *slab = NULL;
+
+#ifdef CGCS_SLIST_CACHE_HUGEPAGES
+#ifdef MAP_HUGETLB
+    slab = mmap(NULL, SLAB_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (slab != MAP_FAILED) {
+        return slab;
+    }
+#endif
+    // No reserved huge pages -- ask for transparent huge pages instead.
+    slab = aligned_alloc(SLAB_SIZE, SLAB_SIZE);
+    assert(slab);
+#ifdef MADV_HUGEPAGE
+    madvise(slab, SLAB_SIZE, MADV_HUGEPAGE);
+#endif
+#else
+    slab = malloc(SLAB_SIZE);
+    assert(slab);
+#endif
+
+    return slab;
+}
+
+// Fills mag with fresh blocks carved from the current slab.
+// Caller holds depot_lock.
+static void
+slab_refill(struct magazine *mag) {
+    while (mag->m_count < MAGAZINE_ROUNDS) {
+        if (slab_remaining < CGCS_SLIST_CACHE_BLOCK_SIZE) {
+            slab_cursor = slab_new();
+            slab_remaining = SLAB_SIZE;
+        }
+
+        mag->m_rounds[mag->m_count++] = slab_cursor;
+        slab_cursor += CGCS_SLIST_CACHE_BLOCK_SIZE;
+        slab_remaining -= CGCS_SLIST_CACHE_BLOCK_SIZE;
+    }
+}
+
+static void
+cache_key_destroy(void *arg) {
+    (void)(arg);
+    slist_cache_thread_flush();
+}
+
+static void
+cache_key_create(void) {
+    pthread_key_create(&cache_key, cache_key_destroy);
+}
+
+static struct thread_cache *
+thread_cache_get(void) {
+    struct thread_cache *tc = &tl_cache;
+
+    if (!tc->m_registered) {
+        // A non-NULL value makes cache_key_destroy run at thread exit.
+        pthread_once(&cache_key_once, cache_key_create);
+        pthread_setspecific(cache_key, tc);
+        tc->m_registered = true;
+    }
+
+    return tc;
+}
+
+static inline struct magazine *
+magazine_new(void) {
+    struct magazine *mag = malloc(sizeof *mag);
+    assert(mag);
+    mag->m_next = NULL;
+    mag->m_count = 0;
+    return mag;
+}
+
+void *slist_cache_alloc(size_t size) {
+    // Checked in every build: a block handed out for a larger request
+    // (e.g. a skip list node) would be overrun by its owner.
+    if (size > CGCS_SLIST_CACHE_BLOCK_SIZE) {
+        fprintf(stderr,
+                "slist_cache_alloc: %zu-byte request exceeds the %zu-byte block size\n",
+                size, (size_t)(CGCS_SLIST_CACHE_BLOCK_SIZE));
+        abort();
+    }
+
+    struct thread_cache *tc = thread_cache_get();
+    struct magazine *loaded = tc->m_loaded;
+
+    if (loaded && loaded->m_count > 0) {
+        return loaded->m_rounds[--loaded->m_count];
+    }
+
+    if (tc->m_previous && tc->m_previous->m_count > 0) {
+        // previous is full: swap it in.
+        tc->m_loaded = tc->m_previous;
+        tc->m_previous = loaded;
+    } else {
+        if (loaded == NULL) {
+            loaded = magazine_new();
+        }
+
+        pthread_mutex_lock(&depot_lock);
+        struct magazine *full = magazine_pop(&depot_full);
+
+        if (full) {
+            magazine_push(&depot_empty, loaded);
+            tc->m_loaded = full;
+        } else {
+            slab_refill(loaded);
+            tc->m_loaded = loaded;
+        }
+        pthread_mutex_unlock(&depot_lock);
+    }
+
+    loaded = tc->m_loaded;
+    return loaded->m_rounds[--loaded->m_count];
+}
+
+void slist_cache_free(void *ptr) {
+    struct thread_cache *tc = thread_cache_get();
+    struct magazine *loaded = tc->m_loaded;
+
+    if (loaded && loaded->m_count < MAGAZINE_ROUNDS) {
+        loaded->m_rounds[loaded->m_count++] = ptr;
+        return;
+    }
+
+    if (tc->m_previous && tc->m_previous->m_count == 0) {
+        // previous is empty: swap it in.
+        tc->m_loaded = tc->m_previous;
+        tc->m_previous = loaded;
+    } else {
+        // Hand the previous (full) magazine to the depot,
+        // and continue with an empty one.
+        pthread_mutex_lock(&depot_lock);
+        if (tc->m_previous) {
+            magazine_push(&depot_full, tc->m_previous);
+        }
+        struct magazine *empty = magazine_pop(&depot_empty);
+        pthread_mutex_unlock(&depot_lock);
+
+        tc->m_previous = loaded;
+        tc->m_loaded = empty ? empty : magazine_new();
+    }
+
+    loaded = tc->m_loaded;
+    loaded->m_rounds[loaded->m_count++] = ptr;
+}
+
+void slist_cache_thread_flush(void) {
+    struct thread_cache *tc = &tl_cache;
+    struct magazine *mags[2] = { tc->m_loaded, tc->m_previous };
+
+    pthread_mutex_lock(&depot_lock);
+    for (int i = 0; i < 2; i++) {
+        if (mags[i]) {
+            magazine_push(mags[i]->m_count ? &depot_full : &depot_empty, mags[i]);
+        }
+    }
+    pthread_mutex_unlock(&depot_lock);
+
+    tc->m_loaded = NULL;
+    tc->m_previous = NULL;
+}
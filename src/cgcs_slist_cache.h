@@ -0,0 +1,42 @@
+/*!
+    \file       cgcs_slist_cache.h
+    \brief      Header file for the thread-caching slist node allocator
+
+    slist_cache_alloc/slist_cache_free match the allocfn/freefn
+    parameters of the slist API, i.e.
+
+        slist_insert_after_alloc_fn(sl, it, &data, slist_cache_alloc);
+        slist_deinit_free_fn(sl, slist_cache_free);
+
+    Only requests of at most CGCS_SLIST_CACHE_BLOCK_SIZE bytes
+    (slist nodes and slist_t) are served; larger ones abort.
+    skiplist_insert_alloc_fn nodes are larger -- do not use it there.
+
+    Each thread keeps two magazines (fixed-size stacks of free blocks),
+    so most calls touch no shared state. Magazines move to and from a
+    shared depot in bulk -- a thread that frees nodes allocated
+    by another thread returns them to the depot one full magazine at a time.
+    When a thread exits, its magazines are returned to the depot.
+
+    Blocks are carved from slabs that are never returned to the system.
+    With CGCS_SLIST_CACHE_HUGEPAGES defined (see the CGCS_SLIST_HUGEPAGES
+    CMake option), slabs are backed by huge pages where available
+    (MAP_HUGETLB, falling back to transparent huge pages).
+ */
+
+#ifndef CGCS_SLIST_CACHE_H
+#define CGCS_SLIST_CACHE_H
+
+#include <stddef.h>
+
+// Blocks are sized for a struct cgcs_slist_node (or an slist_t).
+#define CGCS_SLIST_CACHE_BLOCK_SIZE (2 * sizeof(void *))
+
+void *slist_cache_alloc(size_t size);
+void slist_cache_free(void *ptr);
+
+// Returns the calling thread's magazines to the depot.
+// Called automatically when a thread exits.
+void slist_cache_thread_flush(void);
+
+#endif /* CGCS_SLIST_CACHE_H */
@@ -0,0 +1,215 @@
+/*!
+    \file       cgcs_slist_trace.c
+    \brief      Source file for the slist operation trace recorder
+ */
+
+#include "cgcs_slist_trace.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_BUFFER_RECORDS 4096
+
+// Records are staged here and written in bulk,
+// so recording an operation is a copy into thread-owned memory.
+struct trace_thread {
+    struct trace_thread *m_next;    // trace_threads link
+    unsigned m_generation;          // trace the staged records belong to
+    uint64_t m_last_ns;
+    size_t m_count;
+    struct cgcs_slist_trace_record m_records[TRACE_BUFFER_RECORDS];
+};
+
+// Read without trace_lock on every recorded operation.
+static atomic_bool trace_on = false;
+static atomic_uint trace_generation = 0;   // bumped by every slist_trace_open
+
+// Guard the variables below; taken only to open, close or flush.
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool trace_atexit_registered = false;
+static FILE *trace_fp = NULL;
+static uint64_t trace_open_ns = 0;   // published by the trace_generation store
+static struct trace_thread *trace_threads = NULL;
+
+static pthread_once_t trace_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t trace_key;
+static _Thread_local struct trace_thread *tl_trace = NULL;
+
+// Deltas must not jump when the wall clock is adjusted.
+static inline uint64_t
+trace_now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)(ts.tv_sec) * 1000000000u + (uint64_t)(ts.tv_nsec);
+}
+
+// Caller holds trace_lock. Records staged for an earlier trace are dropped.
+static void
+trace_flush(struct trace_thread *tt) {
+    if (trace_fp && tt->m_generation == atomic_load(&trace_generation)) {
+        fwrite(tt->m_records, sizeof *tt->m_records, tt->m_count, trace_fp);
+    }
+
+    tt->m_count = 0;
+}
+
+// Caller holds trace_lock.
+static void
+trace_close_locked(void) {
+    if (trace_fp == NULL) {
+        return;
+    }
+
+    atomic_store(&trace_on, false);
+
+    for (struct trace_thread *tt = trace_threads; tt; tt = tt->m_next) {
+        trace_flush(tt);
+    }
+
+    fclose(trace_fp);
+    trace_fp = NULL;
+}
+
+// Thread exit: write out what the thread staged, then forget it.
+static void
+trace_key_destroy(void *arg) {
+    struct trace_thread *tt = arg;
+
+    pthread_mutex_lock(&trace_lock);
+    trace_flush(tt);
+
+    for (struct trace_thread **link = &trace_threads; *link; link = &((*link)->m_next)) {
+        if (*link == tt) {
+            *link = tt->m_next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&trace_lock);
+
+    free(tt);
+}
+
+static void
+trace_key_create(void) {
+    pthread_key_create(&trace_key, trace_key_destroy);
+}
+
+static struct trace_thread *
+trace_thread_get(void) {
+    struct trace_thread *tt = tl_trace;
+
+    if (tt == NULL) {
+        tt = calloc(1, sizeof *tt);
+        assert(tt);
+
+        pthread_once(&trace_key_once, trace_key_create);
+        pthread_setspecific(trace_key, tt);
+
+        pthread_mutex_lock(&trace_lock);
+        tt->m_next = trace_threads;
+        trace_threads = tt;
+        pthread_mutex_unlock(&trace_lock);
+
+        tl_trace = tt;
+    }
+
+    return tt;
+}
+
+bool slist_trace_open(const char *path) {
+    pthread_mutex_lock(&trace_lock);
+    trace_close_locked();
+
+    if ((trace_fp = fopen(path, "wb")) == NULL) {
+        pthread_mutex_unlock(&trace_lock);
+        return false;
+    }
+
+    // Staged records reach the file even if slist_trace_close is never called.
+    if (!trace_atexit_registered) {
+        trace_atexit_registered = atexit(slist_trace_close) == 0;
+    }
+
+    fwrite(CGCS_SLIST_TRACE_MAGIC, 1, sizeof(CGCS_SLIST_TRACE_MAGIC) - 1, trace_fp);
+    trace_open_ns = trace_now_ns();
+    atomic_fetch_add(&trace_generation, 1);
+    atomic_store(&trace_on, true);
+    pthread_mutex_unlock(&trace_lock);
+    return true;
+}
+
+void slist_trace_close(void) {
+    pthread_mutex_lock(&trace_lock);
+    trace_close_locked();
+    pthread_mutex_unlock(&trace_lock);
+}
+
+bool slist_trace_active(void) {
+    return atomic_load_explicit(&trace_on, memory_order_relaxed);
+}
+
+void slist_trace_record(enum cgcs_slist_trace_op op,
+                        const void *self,
+                        const void *arg,
+                        const void *result) {
+    if (!atomic_load_explicit(&trace_on, memory_order_acquire)) {
+        return;
+    }
+
+    struct trace_thread *tt = trace_thread_get();
+    const unsigned generation = atomic_load_explicit(&trace_generation, memory_order_acquire);
+
+    if (tt->m_generation != generation) {
+        // First record of this thread since the trace was opened.
+        tt->m_generation = generation;
+        tt->m_last_ns = trace_open_ns;
+        tt->m_count = 0;
+    }
+
+    const uint64_t now = trace_now_ns();
+    const uint64_t delta = now - tt->m_last_ns;
+    tt->m_last_ns = now;
+
+    struct cgcs_slist_trace_record *rec = &(tt->m_records[tt->m_count++]);
+    rec->m_delta_ns = delta > UINT32_MAX ? UINT32_MAX : (uint32_t)(delta);
+    rec->m_op = (uint8_t)(op);
+    memset(rec->m_pad, 0, sizeof rec->m_pad);
+    rec->m_self = (uint64_t)(uintptr_t)(self);
+    rec->m_arg = (uint64_t)(uintptr_t)(arg);
+    rec->m_result = (uint64_t)(uintptr_t)(result);
+
+    if (tt->m_count >= TRACE_BUFFER_RECORDS) {
+        pthread_mutex_lock(&trace_lock);
+        trace_flush(tt);
+        pthread_mutex_unlock(&trace_lock);
+    }
+}
+
+FILE *slist_trace_reader_open(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    char magic[sizeof(CGCS_SLIST_TRACE_MAGIC) - 1];
+
+    if (fp == NULL) {
+        return NULL;
+    }
+
+    if (fread(magic, 1, sizeof magic, fp) != sizeof magic
+        || memcmp(magic, CGCS_SLIST_TRACE_MAGIC, sizeof magic) != 0) {
+        fclose(fp);
+        return NULL;
+    }
+
+    return fp;
+}
+
+bool slist_trace_read(FILE *fp, struct cgcs_slist_trace_record *rec) {
+    return fread(rec, sizeof *rec, 1, fp) == 1;
+}
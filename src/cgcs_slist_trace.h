@@ -0,0 +1,72 @@
+/*!
+    \file       cgcs_slist_trace.h
+    \brief      Header file for the slist operation trace recorder
+
+    When the library is built with CGCS_SLIST_TRACE defined
+    (see the CGCS_SLIST_TRACE CMake option), slist operations
+    are appended to the trace opened by slist_trace_open.
+    While no trace is open, recording an operation costs one atomic load.
+    Each thread stages its records in its own buffer, written to the
+    trace (under a lock) when full, when the thread exits, and by
+    slist_trace_close -- so records of one thread stay in order, but
+    records of different threads appear in blocks, not interleaved.
+    m_delta_ns is measured from the same thread's previous record,
+    with a monotonic clock where available.
+    Call slist_trace_close once other threads have stopped recording.
+    It is also registered with atexit; records are lost if the process
+    ends without either, e.g. through abort or _Exit.
+
+    Trace file layout:
+        CGCS_SLIST_TRACE_MAGIC (8 bytes),
+        followed by struct cgcs_slist_trace_record, repeated.
+
+    Nodes and lists are identified by their addresses at record time;
+    a list's address is also the address of its before_begin node.
+    cgcs_slist_replay maps them onto the nodes it creates.
+    slist_split_after/slist_splice_after(_range) are recorded as
+    node transfers; slist_partition as one single-node transfer per node.
+    slist_deinit_step records each call, with its budget.
+ */
+
+#ifndef CGCS_SLIST_TRACE_H
+#define CGCS_SLIST_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define CGCS_SLIST_TRACE_MAGIC "CGSLTRC1"
+
+enum cgcs_slist_trace_op {
+    CGCS_SLIST_TRACE_INSERT_AFTER = 1,  // m_self: list, m_arg: it, m_result: new node
+    CGCS_SLIST_TRACE_PUSH_FRONT,        // m_self: list, m_result: new node
+    CGCS_SLIST_TRACE_ERASE_AFTER,       // m_self: list, m_arg: it
+    CGCS_SLIST_TRACE_POP_FRONT,         // m_self: list
+    CGCS_SLIST_TRACE_FIND,              // m_self: list, m_arg: beg, m_result: found node (0 if end)
+    CGCS_SLIST_TRACE_TRANSFER,          // m_self: x, m_arg: start, m_result: finish
+    CGCS_SLIST_TRACE_DEINIT,            // m_self: list
+    CGCS_SLIST_TRACE_DEINIT_STEP        // m_self: list, m_arg: budget
+};
+
+struct cgcs_slist_trace_record {
+    uint32_t m_delta_ns;    // nanoseconds since the thread's previous record (saturated)
+    uint8_t m_op;           // enum cgcs_slist_trace_op
+    uint8_t m_pad[3];
+    uint64_t m_self;
+    uint64_t m_arg;
+    uint64_t m_result;
+};
+
+bool slist_trace_open(const char *path);
+void slist_trace_close(void);
+bool slist_trace_active(void);
+
+void slist_trace_record(enum cgcs_slist_trace_op op,
+                        const void *self,
+                        const void *arg,
+                        const void *result);
+
+FILE *slist_trace_reader_open(const char *path);
+bool slist_trace_read(FILE *fp, struct cgcs_slist_trace_record *rec);
+
+#endif /* CGCS_SLIST_TRACE_H */